@@ -0,0 +1,81 @@
+/*
+ * This example uses the BuzzKill and BuzzKillAutomation classes from the BuzzKill library.
+ * It plays a melody with portamento (each note glides into the next), adds vibrato once each note has arrived,
+ * slowly varies the pulse width of the voice with a software LFO, and fades out at the end, all without using
+ * any of the board's mod oscillators or patch slots.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillAutomation.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Create a BuzzKillAutomation object, which makes gradual changes to the registers of our BuzzKill object.
+BuzzKillAutomation automation(buzzkill);
+
+// The notes of the melody (MIDI note numbers).
+const byte notes[] = { 60, 67, 65, 64, 62, 72, 67, 60 };
+
+// Wait for a number of milliseconds, keeping the automation running in the meantime.
+void wait(unsigned long ms) {
+  unsigned long start = millis();
+  while (millis() - start < ms) automation.poll();
+}
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, set up voice oscillator 0 as a Pulse wave, and start it sounding.
+  buzzkill.resetRegisters();
+  buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 0, BUZZKILL_SHAPE_PULSE);
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, notes[0]);
+  buzzkill.enableVoice(0);
+  buzzkill.noteOn(0);
+
+  // Vary the midpoint (the pulse width) by up to 96 either way, once every 2 seconds (8/16ths of a hertz).
+  // This keeps running until it is cancelled.
+  automation.addMidpointLFO(BUZZKILL_OSCTYPE_VOICE, 0, 8, 96);
+}
+
+void loop() {
+  // Each note glides in from the last one over 120 ms. Once it arrives, a 5.5 Hz vibrato of 25 cents either way
+  // takes over; since both change the frequency, starting one replaces the other.
+  for (byte step=0; step<8; ++step) {
+    automation.glideNote(BUZZKILL_OSCTYPE_VOICE, 0, notes[step], 120);
+    wait(150);
+    automation.addVibrato(BUZZKILL_OSCTYPE_VOICE, 0, 88, 25);
+    wait(450);
+  }
+
+  // Fade out over 1.5 seconds, then pause before turning the volume back up (with no fade) and starting again.
+  automation.fadeMasterVolume(0, 1500);
+  wait(2500);
+  automation.fadeMasterVolume(15, 0);
+}
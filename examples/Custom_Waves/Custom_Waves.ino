@@ -0,0 +1,87 @@
+/*
+ * This example uses the BuzzKill and BuzzKillWave classes from the BuzzKill library.
+ * It builds custom waveforms on the Arduino: a sawtooth morphing into a square wave, and a pulse wave getting narrower.
+ * Each wave is sent to the board with storeCustomWave(), which skips the upload if the board already holds that wave.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillWave.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Space to build each wave.
+byte wave[256];
+
+// Play one note (a MIDI note number) for 200 ms, followed by a short gap.
+void playNote(byte note) {
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, note);
+  buzzkill.noteOn(0);
+  delay(200);
+  buzzkill.noteOff(0);
+  delay(50);
+}
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, and set up voice 0 to play the custom wave, with a quick envelope.
+  buzzkill.resetRegisters();
+  buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 0, BUZZKILL_SHAPE_CUSTOM);
+  buzzkill.configureEnvelope(0, BUZZKILL_CURVE_NATURAL, 5, 100, 80, 100, 15, false);
+  buzzkill.enableVoice(0);
+}
+
+void loop() {
+  // Morph from a sawtooth to a square wave in 8 steps. Each step builds a sawtooth, then blends a square wave into it;
+  // the blend is done in place, so no second array is needed. 24 harmonics keep the waves clean at these notes.
+  for (byte step=0; step<=8; ++step) {
+    BuzzKillWave::sawtooth(wave, 24);
+    BuzzKillWave::square(wave, 24, step * 255 / 8);
+    buzzkill.storeCustomWave(wave);
+    playNote(48 + step);
+  }
+
+  // Make a pulse wave narrower, from a square wave (half the cycle) down to 1/16th of the cycle.
+  for (byte width=128; width>=16; width/=2) {
+    BuzzKillWave::pulse(wave, width, 24);
+    buzzkill.storeCustomWave(wave);
+    playNote(57);
+  }
+
+  // Play a phrase with the last wave. A sound routine might store its wave before every note, as here; since the board
+  // already holds this wave, nothing is sent, so there is no delay.
+  const byte phrase[] = { 57, 60, 64, 69 };
+  for (byte index=0; index<4; ++index) {
+    buzzkill.storeCustomWave(wave);
+    playNote(phrase[index]);
+  }
+
+  delay(1000);
+}
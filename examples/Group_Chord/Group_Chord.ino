@@ -0,0 +1,84 @@
+/*
+ * This example uses the BuzzKill and BuzzKillGroup classes from the BuzzKill library.
+ * It plays an eight-note chord across two BuzzKill boards, using the voices of both boards as a single pool.
+ * It demonstrates broadcasting the same settings to several boards, and restarting their oscillators together.
+ *
+ * PLEASE NOTE: This example uses SPI by default, with the boards selected by pins 9 and 10. If you have connected your
+ * BuzzKill boards using I2C instead, see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillGroup.h>
+
+// Create a BuzzKill object for each board.
+BuzzKill buzzkill1;
+BuzzKill buzzkill2;
+
+// Create a BuzzKillGroup object, which drives both boards together.
+BuzzKill *boards[] = { &buzzkill1, &buzzkill2 };
+BuzzKillGroup group(boards, 2);
+
+// The notes of the chord (MIDI note numbers): a C major chord spread over three octaves.
+const byte notes[] = { 36, 48, 55, 60, 64, 67, 72, 76 };
+
+void setup() {
+  // If using SPI, the following three lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill1.beginSPI(9);
+  buzzkill2.beginSPI(10);
+
+  // If using I2C, the following three lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  // The second board must first be given its own address, using changeI2CAddress().
+  //Wire.begin();
+  //buzzkill1.beginI2C(10);
+  //buzzkill2.beginI2C(11);
+}
+
+void loop() {
+  // Set up both boards the same way: a Triangle wave on every voice, each at a quiet mix volume, since there are
+  // eight voices in all. Any BuzzKill method can be used inside the braces.
+  group.broadcast([](BuzzKill &buzzkill) {
+    buzzkill.resetRegisters();
+    for (byte voice=0; voice<4; ++voice) {
+      buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, voice, BUZZKILL_SHAPE_TRIANGLE);
+      buzzkill.configureEnvelope(voice, BUZZKILL_CURVE_NATURAL, 20, 300, 80, 800, 2, false);
+    }
+    buzzkill.enableVoice(true, true, true, true);
+  });
+
+  // Give each voice in the pool its own note. Voices 0-3 are on the first board, and 4-7 on the second.
+  for (byte voice=0; voice<group.voiceCount(); ++voice) group.setNoteFrequency(voice, notes[voice]);
+
+  // Restart all voice oscillators on both boards together, so that the notes begin in phase.
+  group.restartOscillators(0xf0);
+
+  // Play the chord, one voice after another, then hold it for 2 seconds.
+  for (byte voice=0; voice<group.voiceCount(); ++voice) {
+    group.noteOn(voice);
+    delay(100);
+  }
+  delay(2000);
+
+  // Release all the notes together, and wait 2 seconds before doing it all again.
+  group.broadcast([](BuzzKill &buzzkill) {
+    buzzkill.noteOn(false, false, false, false);
+  });
+  delay(2000);
+}
@@ -0,0 +1,98 @@
+/*
+ * This example uses the BuzzKill, BuzzKillPoly and BuzzKillMidi classes from the BuzzKill library.
+ * It plays a short Standard MIDI File stored in program memory, over and over. To play your own song, convert a .mid file
+ * to a list of bytes (e.g. with "xxd -i song.mid"), or read it from an SD card using the other form of begin().
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillPoly.h>
+#include <BuzzKillMidi.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Create a BuzzKillPoly object, which assigns notes to the voices of our BuzzKill object.
+BuzzKillPoly poly(buzzkill);
+
+// Create a BuzzKillMidi object, which plays the notes of a MIDI file on our BuzzKillPoly object.
+BuzzKillMidi midi(poly);
+
+// The song: "Ode to Joy", with the melody on MIDI channel 1 and a bass line on channel 2.
+// This is the complete contents of a .mid file, kept in program memory so that it takes no RAM.
+const byte song[] PROGMEM = {
+  0x4d, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x60, 0x4d, 0x54,
+  0x72, 0x6b, 0x00, 0x00, 0x01, 0x3f, 0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20, 0x00, 0x90, 0x40,
+  0x5a, 0x00, 0x91, 0x30, 0x46, 0x58, 0x80, 0x40, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x58, 0x80, 0x40,
+  0x00, 0x08, 0x90, 0x41, 0x5a, 0x58, 0x80, 0x41, 0x00, 0x08, 0x90, 0x43, 0x5a, 0x58, 0x80, 0x43,
+  0x00, 0x00, 0x81, 0x30, 0x00, 0x08, 0x90, 0x43, 0x5a, 0x00, 0x91, 0x2b, 0x46, 0x58, 0x80, 0x43,
+  0x00, 0x08, 0x90, 0x41, 0x5a, 0x58, 0x80, 0x41, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x58, 0x80, 0x40,
+  0x00, 0x08, 0x90, 0x3e, 0x5a, 0x58, 0x80, 0x3e, 0x00, 0x00, 0x81, 0x2b, 0x00, 0x08, 0x90, 0x3c,
+  0x5a, 0x00, 0x91, 0x30, 0x46, 0x58, 0x80, 0x3c, 0x00, 0x08, 0x90, 0x3c, 0x5a, 0x58, 0x80, 0x3c,
+  0x00, 0x08, 0x90, 0x3e, 0x5a, 0x58, 0x80, 0x3e, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x58, 0x80, 0x40,
+  0x00, 0x00, 0x81, 0x30, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x00, 0x91, 0x2b, 0x46, 0x81, 0x08, 0x80,
+  0x40, 0x00, 0x08, 0x90, 0x3e, 0x5a, 0x28, 0x80, 0x3e, 0x00, 0x08, 0x90, 0x3e, 0x5a, 0x81, 0x38,
+  0x80, 0x3e, 0x00, 0x00, 0x81, 0x2b, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x00, 0x91, 0x30, 0x46, 0x58,
+  0x80, 0x40, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x58, 0x80, 0x40, 0x00, 0x08, 0x90, 0x41, 0x5a, 0x58,
+  0x80, 0x41, 0x00, 0x08, 0x90, 0x43, 0x5a, 0x58, 0x80, 0x43, 0x00, 0x00, 0x81, 0x30, 0x00, 0x08,
+  0x90, 0x43, 0x5a, 0x00, 0x91, 0x2b, 0x46, 0x58, 0x80, 0x43, 0x00, 0x08, 0x90, 0x41, 0x5a, 0x58,
+  0x80, 0x41, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x58, 0x80, 0x40, 0x00, 0x08, 0x90, 0x3e, 0x5a, 0x58,
+  0x80, 0x3e, 0x00, 0x00, 0x81, 0x2b, 0x00, 0x08, 0x90, 0x3c, 0x5a, 0x00, 0x91, 0x2b, 0x46, 0x58,
+  0x80, 0x3c, 0x00, 0x08, 0x90, 0x3c, 0x5a, 0x58, 0x80, 0x3c, 0x00, 0x08, 0x90, 0x3e, 0x5a, 0x58,
+  0x80, 0x3e, 0x00, 0x08, 0x90, 0x40, 0x5a, 0x58, 0x80, 0x40, 0x00, 0x00, 0x81, 0x2b, 0x00, 0x08,
+  0x90, 0x3e, 0x5a, 0x00, 0x91, 0x30, 0x46, 0x81, 0x08, 0x80, 0x3e, 0x00, 0x08, 0x90, 0x3c, 0x5a,
+  0x28, 0x80, 0x3c, 0x00, 0x08, 0x90, 0x3c, 0x5a, 0x81, 0x38, 0x80, 0x3c, 0x00, 0x00, 0x81, 0x30,
+  0x00, 0x00, 0xff, 0x2f, 0x00
+};
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values.
+  // This is often a good idea when starting a new sequence, to make sure we start from a known state.
+  buzzkill.resetRegisters();
+
+  // Set up all four voices the same way: a Triangle wave, with a quick attack and a short release.
+  // Only notes and pitch bends are taken from the file, so the sound of each voice is set here.
+  buzzkill.beginBatch();
+  for (byte voice=0; voice<4; ++voice) {
+    buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, voice, BUZZKILL_SHAPE_TRIANGLE);
+    buzzkill.configureEnvelope(voice, BUZZKILL_CURVE_NATURAL, 10, 150, 80, 150, 0, false);
+  }
+  buzzkill.enableVoice(true, true, true, true);
+  buzzkill.commitBatch();
+
+  // Load the song, and start playing it, repeating whenever it ends.
+  if (midi.begin(song, sizeof(song))) midi.play(true);
+}
+
+void loop() {
+  // Play whatever notes are due. This must be called often; other work can be done here too, as long as it doesn't
+  // wait too long, since a note that is due is only played at the next call.
+  midi.poll();
+}
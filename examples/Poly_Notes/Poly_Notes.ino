@@ -0,0 +1,84 @@
+/*
+ * This example uses the BuzzKill and BuzzKillPoly classes from the BuzzKill library.
+ * It plays a sequence of overlapping notes by note number, letting BuzzKillPoly choose a voice for each one.
+ * With a MIDI input, the same noteOn() and noteOff() calls can be made from the MIDI note messages instead.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillPoly.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Create a BuzzKillPoly object, which assigns notes to the voices of our BuzzKill object.
+BuzzKillPoly poly(buzzkill);
+
+// The notes to play (MIDI note numbers), and how hard each one is played (1..127).
+// Each note is held while the next four start, so up to five notes would overlap; with only four voices,
+// the oldest note is cut off ("stolen") to make room for the newest.
+const byte notes[] = { 48, 55, 60, 64, 67, 72, 76, 79, 84, 88 };
+const byte velocities[] = { 127, 80, 90, 100, 110, 127, 110, 100, 90, 80 };
+
+// The current pitch bend, in cents.
+int bend = 0;
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values.
+  // This is often a good idea when starting a new sequence, to make sure we start from a known state.
+  buzzkill.resetRegisters();
+
+  // Set up all four voices the same way: a Ramp wave, with a quick attack and a gentle release.
+  // BuzzKillPoly only changes the frequency, mix volume and gate, so everything else is set here.
+  buzzkill.beginBatch();
+  for (byte voice=0; voice<4; ++voice) {
+    buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, voice, BUZZKILL_SHAPE_RAMP);
+    buzzkill.configureEnvelope(voice, BUZZKILL_CURVE_NATURAL, 10, 200, 90, 400, 0, false);
+  }
+  buzzkill.enableVoice(true, true, true, true);
+  buzzkill.commitBatch();
+}
+
+void loop() {
+  // Start each note 200 ms after the previous one, and stop it 800 ms after it started. Since each note starts
+  // before the one four steps earlier stops, the oldest voice is stolen; stopping a note that was stolen has no effect.
+  for (byte step=0; step<14; ++step) {
+    if (step < 10) poly.noteOn(notes[step], velocities[step]);
+    if (step >= 4) poly.noteOff(notes[step-4]);
+    delay(200);
+  }
+
+  // Play the sequence a whole tone higher next time, then back again, by bending the pitch of every note.
+  bend = 200 - bend;
+  poly.pitchBend(bend);
+
+  // Wait 1 second before doing it all again.
+  delay(1000);
+}
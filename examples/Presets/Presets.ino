@@ -0,0 +1,80 @@
+/*
+ * This example uses the BuzzKill class from the BuzzKill library.
+ * It plays the Siren and Alarm sound effects from the Sound_Effects example, repeating every 10 seconds.
+ * It demonstrates building complete sound presets at compile time, and loading each one with a single transfer.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Build the Siren preset. Each call works like the BuzzKill method of the same name, starting from the reset state,
+// but all of the work is done by the compiler and only the finished register values are stored in program memory.
+// Because the preset is declared constexpr, a value out of range (such as a voice number of 4) is a compile error.
+constexpr buzzkill_preset_t siren PROGMEM = BuzzKillPreset<>()
+    .configureOscillator(BUZZKILL_OSCTYPE_VOICE, 0, 1000, BUZZKILL_SHAPE_SINE)
+    .configureOscillator(BUZZKILL_OSCTYPE_MOD, 0, 0.5, BUZZKILL_SHAPE_SINE)
+    .addPatch(0, 0, BUZZKILL_PATCH_FREQSCALE, 40)
+    .enableVoice(0)
+    .image();
+
+// Build the Alarm preset in the same way.
+constexpr buzzkill_preset_t alarm PROGMEM = BuzzKillPreset<>()
+    .configureOscillator(BUZZKILL_OSCTYPE_VOICE, 0, 500, BUZZKILL_SHAPE_PULSE)
+    .configureOscillator(BUZZKILL_OSCTYPE_MOD, 0, 8, BUZZKILL_SHAPE_SINE)
+    .configureOscillator(BUZZKILL_OSCTYPE_MOD, 1, 1, BUZZKILL_SHAPE_HILLTOP)
+    .addPatch(0, 0, BUZZKILL_PATCH_FREQSCALE, 40)
+    .addPatch(1, 0, BUZZKILL_PATCH_AMPSCALE, 150)
+    .enableVoice(0)
+    .image();
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, so the library knows what the board holds.
+  // After this, loading a preset only sends the registers that differ.
+  buzzkill.resetRegisters();
+}
+
+void loop() {
+  // Load the Siren preset, start the note playing, and let it play for 3 seconds.
+  buzzkill.loadPreset(siren);
+  buzzkill.noteOn(0);
+  delay(3000);
+
+  // Load the Alarm preset. Setting keepGates leaves the note playing, so the sound changes without restarting.
+  // Let it play for 3 seconds.
+  buzzkill.loadPreset(alarm, true);
+  delay(3000);
+
+  // Stop the note and wait 4 seconds before doing it all again.
+  buzzkill.noteOff(0);
+  delay(4000);
+}
@@ -0,0 +1,88 @@
+/*
+ * This example uses the BuzzKill class from the BuzzKill library.
+ * It holds a chord and switches between three modulation routings on every beat with setRouting(). Patches shared by
+ * two routings stay in their slots, so each switch sends only the few registers that differ.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Each route is: source mod oscillator, destination voice, patch type, patch parameter.
+// Vibrato on both voices.
+const buzzkill_route_t vibrato[] = {
+  { 0, 0, BUZZKILL_PATCH_FREQSCALE, 40 },
+  { 0, 1, BUZZKILL_PATCH_FREQSCALE, 40 }
+};
+
+// The same vibrato, plus tremolo on voice 0; the two vibrato patches are kept.
+const buzzkill_route_t tremolo[] = {
+  { 0, 0, BUZZKILL_PATCH_FREQSCALE, 40 },
+  { 0, 1, BUZZKILL_PATCH_FREQSCALE, 40 },
+  { 1, 0, BUZZKILL_PATCH_AMPSCALE, 150 }
+};
+
+// Ring modulation on voice 1, with deeper vibrato on voice 0; only the changed registers are sent.
+const buzzkill_route_t ring[] = {
+  { 0, 0, BUZZKILL_PATCH_FREQSCALE, 80 },
+  { 2, 1, BUZZKILL_PATCH_RINGMOD, 0 }
+};
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, then set up the mod oscillators used as sources.
+  buzzkill.resetRegisters();
+  buzzkill.configureOscillator(BUZZKILL_OSCTYPE_MOD, 0, 6, BUZZKILL_SHAPE_SINE);
+  buzzkill.configureOscillator(BUZZKILL_OSCTYPE_MOD, 1, 4, BUZZKILL_SHAPE_TRIANGLE);
+  buzzkill.configureOscillator(BUZZKILL_OSCTYPE_MOD, 2, 300, BUZZKILL_SHAPE_SINE);
+
+  // Hold a fifth on voices 0 and 1.
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, 57);
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 1, 64);
+  buzzkill.configureEnvelope(0, BUZZKILL_CURVE_NATURAL, 20, 100, 100, 200, 8, true);
+  buzzkill.configureEnvelope(1, BUZZKILL_CURVE_NATURAL, 20, 100, 100, 200, 8, true);
+  buzzkill.enableVoice(0);
+  buzzkill.enableVoice(1);
+}
+
+void loop() {
+  // Switch routing on every beat, at 120 beats per minute.
+  buzzkill.setRouting(vibrato, 2);
+  delay(500);
+  buzzkill.setRouting(tremolo, 3);
+  delay(500);
+  buzzkill.setRouting(ring, 2);
+  delay(500);
+}
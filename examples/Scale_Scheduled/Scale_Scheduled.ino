@@ -0,0 +1,75 @@
+/*
+ * This example uses the BuzzKill class from the BuzzKill library.
+ * It plays a simple 5-note scale, repeating every 15 seconds, without ever calling delay().
+ * It demonstrates using the event scheduler, so the sketch stays free to do other work while notes play.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Space for the scheduler to hold pending events. Each note frequency takes two events.
+buzzkill_event_t events[16];
+
+// The raw frequencies (1/16ths of a hertz) for the notes of the scale: 262, 294, 330, 392 and 440 Hz.
+const word notes[] = { 4192, 4704, 5280, 6272, 7040 };
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, and set up voice oscillator 0 as a Triangle wave.
+  buzzkill.resetRegisters();
+  buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 0, BUZZKILL_SHAPE_TRIANGLE);
+  buzzkill.enableVoice(0);
+
+  // Give the scheduler its space for events.
+  buzzkill.beginSchedule(events, 16);
+
+  // Schedule everything relative to a common starting time, half a second from now.
+  // Every event repeats every 15 seconds: 5 seconds of notes followed by 10 seconds of silence.
+  unsigned long start = micros() + 500000;
+  const unsigned long period = 15000000;
+
+  // Each note starts 1 second after the previous one.
+  for (byte note = 0; note < 5; ++note) {
+    buzzkill.scheduleFrequencyRaw(start + note * 1000000UL, BUZZKILL_OSCTYPE_VOICE, 0, notes[note], period);
+  }
+
+  // Start the note with the first frequency, and stop it after the last one has played for 1 second.
+  buzzkill.scheduleNoteOn(start, 0, true, period);
+  buzzkill.scheduleNoteOn(start + 5000000UL, 0, false, period);
+}
+
+void loop() {
+  // Carry out any events that are due. This needs to be called often, since events can't happen any sooner.
+  buzzkill.poll();
+
+  // Any other work can be done here, as long as it doesn't take too long.
+}
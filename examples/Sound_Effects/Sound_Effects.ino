@@ -1,7 +1,7 @@
 /*
  * This example uses the BuzzKill class from the BuzzKill library.
  * It plays three separate sound effects, repeating every 10 seconds.
- * It demonstrates using modulation oscillators and patches to alter sound output.
+ * It demonstrates using modulation oscillators and patches to alter sound output, and batching register updates.
  *
  * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
  * see the comments within the setup() function for the appropriate changes.
@@ -53,7 +53,8 @@ void loop() {
 
   // Set the frequency for modulation oscillator 0 to 1/2 Hz.
   // This will provide the "sweeping" action that alters the base frequency.
-  buzzkill.setFrequency(BUZZKILL_OSCTYPE_MOD, 0, 0.5);
+  // The raw frequency value is given in 1/16ths of a hertz, so 8 means 1/2 Hz.
+  buzzkill.setFrequencyRaw(BUZZKILL_OSCTYPE_MOD, 0, 8);
 
   // Add a patch between the two oscillators, so that mod osc 0 alters the frequency of voice osc 0.
   buzzkill.addPatch(0, 0, BUZZKILL_PATCH_FREQSCALE, 40);
@@ -70,6 +71,10 @@ void loop() {
   // Reset all registers to their default values. This will stop all ongoing sounds.
   buzzkill.resetRegisters();
 
+  // Begin a batch of updates. Everything up to commitBatch() is collected and sent in just a few transfers,
+  // which is much faster than sending each change separately.
+  buzzkill.beginBatch();
+
   // Configure voice oscillator 0 as a 500 Hz Pulse wave.
   // This will provide the base frequency for the alarm.
   buzzkill.configureOscillator(BUZZKILL_OSCTYPE_VOICE, 0, 500, BUZZKILL_SHAPE_PULSE);
@@ -91,8 +96,11 @@ void loop() {
   // Enable the output for voice oscillator 0.
   buzzkill.enableVoice(0);
 
-  // Start the note playing, and let it play for 3 seconds.
+  // Start the note playing.
   buzzkill.noteOn(0);
+
+  // Send all of the batched updates at once, then let the note play for 3 seconds.
+  buzzkill.commitBatch();
   delay(3000);
 
   /** Compute Sound Effect **/
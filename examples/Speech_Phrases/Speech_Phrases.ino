@@ -0,0 +1,73 @@
+/*
+ * This example uses the BuzzKill class from the BuzzKill library.
+ * It speaks three phrases in turn, one every 5 seconds.
+ * It demonstrates defining speech phrases at compile time and keeping them, with a phrase dictionary, in program memory.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Define each phrase using the symbolic tag for each phoneme, as for addSpeechTags().
+// The tags are converted to phoneme values by the compiler, so a misspelled tag is a compile error,
+// and the phrases are stored in program memory rather than RAM.
+BUZZKILL_PHRASE(hello, "H* EH L* OW _3 M* AY N* EY M* IH Z* _1 B* AH Z* K* IH L*");
+BUZZKILL_PHRASE(morning, "G* UH D* _1 M* AO R* N* IH NG");
+BUZZKILL_PHRASE(goodbye, "G* UH D* _1 B* AY");
+
+// List the phrases in a dictionary, also stored in program memory, so they can be chosen by number.
+const byte * const phrases[] PROGMEM = { hello, morning, goodbye };
+
+// The number of the next phrase to speak.
+byte phraseNum = 0;
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values.
+  // This is often a good idea when starting a new sequence, to make sure we start from a known state.
+  buzzkill.resetRegisters();
+
+  // Set oscillators, envelopes and patches to proper values for producing speech at a pitch of 160 Hz.
+  buzzkill.prepareSpeechMode(160, BUZZKILL_PATCH_HARDSYNCMULTI);
+}
+
+void loop() {
+  // Replace the contents of the speech buffer with the next phrase, sent directly from program memory.
+  buzzkill.clearSpeechBuffer();
+  buzzkill.addSpeechPhrase(phrases, phraseNum);
+
+  // Begin speaking from the speech buffer.
+  buzzkill.startSpeaking();
+
+  // Move on to the next phrase, and wait 5 seconds before speaking it.
+  phraseNum = (phraseNum + 1) % 3;
+  delay(5000);
+}
@@ -0,0 +1,91 @@
+/*
+ * This example uses the BuzzKill, BuzzKillSpeech and BuzzKillText classes from the BuzzKill library.
+ * It reads a long passage aloud, far longer than fits in the board's speech buffer at once, and flashes the built-in LED
+ * in time with the vowels. It demonstrates streaming speech to the board a few phonemes at a time while it speaks.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillSpeech.h>
+#include <BuzzKillText.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Space for phonemes waiting to be spoken, and a BuzzKillSpeech player that sends them to the board as they are needed.
+byte speechBuffer[64];
+BuzzKillSpeech speech(buzzkill, speechBuffer, sizeof(speechBuffer));
+
+// Create a BuzzKillText object, which converts text to phonemes for the player.
+BuzzKillText text(speech);
+
+// When the passage was last finished.
+unsigned long lastFinished = 0;
+
+// Called by the player as each phoneme begins. Phonemes 0..19 are vowels, and 255 means the speech is finished.
+void showPhoneme(byte phoneme) {
+  digitalWrite(LED_BUILTIN, phoneme < 20 ? HIGH : LOW);
+  if (phoneme == 255) lastFinished = millis();
+}
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values.
+  // This is often a good idea when starting a new sequence, to make sure we start from a known state.
+  buzzkill.resetRegisters();
+
+  // Set oscillators, envelopes and patches to proper values for producing speech at a pitch of 160 Hz.
+  buzzkill.prepareSpeechMode(160, BUZZKILL_PATCH_HARDSYNCMULTI);
+
+  // Set the speech speed through the player, so that its timing estimates match the board.
+  speech.setSpeed(150);
+
+  // Flash the LED with the vowels.
+  pinMode(LED_BUILTIN, OUTPUT);
+  speech.onPhoneme(showPhoneme);
+}
+
+void loop() {
+  // Keep the player going. This sends a few more phonemes to the board whenever it is running low.
+  speech.poll();
+
+  // Read the passage again, 5 seconds after it was last finished.
+  if (!speech.isSpeaking() && millis() - lastFinished >= 5000) {
+    // Whenever the player's buffer is full, print() waits while the board speaks, so much of the passage is spoken
+    // during these lines. The player starts speaking by itself the first time its buffer fills up.
+    text.print(F("Four score and seven years ago our fathers brought forth on this continent, a new nation, "));
+    text.print(F("conceived in Liberty, and dedicated to the proposition that all men are created equal. "));
+    text.print(F("Now we are engaged in a great civil war, testing whether that nation, "));
+    text.print(F("or any nation so conceived and so dedicated, can long endure."));
+    text.flush();
+
+    // Start the player, in case the passage was short enough that it has not started already.
+    speech.start();
+  }
+}
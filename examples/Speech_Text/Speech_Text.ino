@@ -0,0 +1,71 @@
+/*
+ * This example uses the BuzzKill and BuzzKillText classes from the BuzzKill library.
+ * It speaks a status message every 10 seconds, reporting how long the sketch has been running.
+ * It demonstrates converting ordinary English text, including numbers, into speech at run time.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillText.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Create a BuzzKillText object, which converts text to phonemes for the speech buffer of our BuzzKill object.
+BuzzKillText text(buzzkill);
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values.
+  // This is often a good idea when starting a new sequence, to make sure we start from a known state.
+  buzzkill.resetRegisters();
+
+  // Set oscillators, envelopes and patches to proper values for producing speech at a pitch of 160 Hz.
+  buzzkill.prepareSpeechMode(160, BUZZKILL_PATCH_HARDSYNCMULTI);
+}
+
+void loop() {
+  // Clear any phonemes left from the last message.
+  buzzkill.clearSpeechBuffer();
+
+  // Write the message, just as if printing it to the Serial monitor. Numbers are spoken as words,
+  // and punctuation adds pauses. The text is converted a word at a time, so it is never stored as a whole.
+  text.print("Hello. I have been running for ");
+  text.print(millis() / 1000);
+  text.print(" seconds.");
+
+  // Send the last word. This must be done at the end of each message.
+  text.flush();
+
+  // Begin speaking from the speech buffer.
+  buzzkill.startSpeaking();
+
+  // Wait 10 seconds before doing it all again.
+  delay(10000);
+}
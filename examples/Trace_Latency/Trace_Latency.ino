@@ -0,0 +1,92 @@
+/*
+ * This example uses the BuzzKill class from the BuzzKill library.
+ * It measures how long notes take to reach the board, by recording every bus transfer and dumping the records over
+ * Serial. Tracing is compiled out unless BUZZKILL_TRACE is defined for the library as well as the sketch, so add
+ * -DBUZZKILL_TRACE to the build flags (or un-comment it in BuzzKill.h). Capture the serial output to a file,
+ * e.g. with a terminal program's logging, and read it with extras/host/trace_decode.cpp.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Space for queued commands.
+byte queue[64];
+
+#ifdef BUZZKILL_TRACE
+// Space for 32 transfer records; once full, the oldest are replaced.
+buzzkill_trace_t trace[32];
+#endif
+
+void setup() {
+  Serial.begin(115200);
+
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, and set up voice 0 with a short envelope.
+  buzzkill.resetRegisters();
+  buzzkill.configureEnvelope(0, BUZZKILL_CURVE_NATURAL, 5, 100, 80, 100, 15, false);
+  buzzkill.enableVoice(0);
+
+#ifdef BUZZKILL_TRACE
+  BuzzKill::beginTrace(trace, 32);
+#else
+  Serial.println("BUZZKILL_TRACE is not defined, so nothing is recorded.");
+#endif
+}
+
+void loop() {
+  // Play a note directly: each call waits while its registers are sent.
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, 60);
+  buzzkill.noteOn(0);
+  delay(200);
+  buzzkill.noteOff(0);
+  delay(100);
+
+  // Play a note through the queue: the calls return at once, and poll() sends the commands later.
+  // The decoder shows how long each queued command waited.
+  buzzkill.beginQueue(queue, sizeof(queue));
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, 64);
+  buzzkill.noteOn(0);
+  while (!buzzkill.isIdle()) buzzkill.poll(100);
+  delay(200);
+  buzzkill.noteOff(0);
+  buzzkill.endQueue();
+  delay(100);
+
+#ifdef BUZZKILL_TRACE
+  BuzzKill::dumpTrace(Serial);
+#endif
+  delay(1000);
+}
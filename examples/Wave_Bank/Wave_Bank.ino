@@ -0,0 +1,147 @@
+/*
+ * This example uses the BuzzKill and BuzzKillWave classes from the BuzzKill library.
+ * It keeps a bank of custom waveforms in program memory, in compressed form, and plays a few notes with each in turn.
+ * loadCustomWave() decodes each wave as it is sent to the board, so the waves take no RAM at all.
+ *
+ * The waves here were made with BuzzKillWave and compressed with BuzzKillWave::compress(). To make your own, call
+ * printWave() from setup() with a wave of your own, and paste the output from the Serial Monitor into your sketch.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillWave.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// The waves, compressed. Each would take 256 bytes uncompressed.
+const byte sawtooth[] PROGMEM = {
+  70, 128, 227, 229, 233, 236, 241, 247, 63, 176, 54, 119, 117, 48, 14, 221, 238, 1, 51, 52,
+  50, 32, 15, 254, 0, 2, 34, 51, 33, 16, 0, 240, 241, 17, 35, 34, 33, 1, 240, 0,
+  1, 8, 18, 34, 33, 33, 0, 132, 11, 17, 18, 18, 34, 16, 16, 131, 56, 17, 33, 34,
+  33, 16, 16, 0, 1, 17, 18, 34, 17, 16, 1, 0, 1, 17, 34, 33, 17, 16, 0, 1,
+  1, 18, 34, 18, 17, 0, 131, 11, 16, 18, 34, 18, 17, 16, 132, 63, 18, 18, 34, 33,
+  16, 0, 15, 16, 18, 34, 50, 17, 31, 15, 0, 1, 18, 51, 34, 32, 0, 239, 240, 2,
+  35, 67, 51, 16, 238, 221, 224, 3, 7, 87, 119, 99, 11, 68, 247, 241, 236, 233, 229
+};
+const byte square[] PROGMEM = {
+  70, 128, 26, 26, 23, 19, 15, 10, 63, 98, 236, 186, 187, 239, 18, 52, 51, 32, 14, 237,
+  222, 240, 1, 34, 34, 17, 255, 254, 238, 240, 1, 33, 34, 16, 15, 239, 239, 255, 17, 18,
+  18, 51, 16, 15, 238, 254, 240, 1, 34, 33, 17, 255, 238, 238, 240, 1, 35, 50, 32, 14,
+  221, 205, 239, 18, 85, 101, 66, 234, 75, 246, 241, 237, 233, 230, 230, 229, 230, 233, 237, 241,
+  246, 63, 174, 36, 86, 85, 33, 254, 220, 221, 224, 2, 35, 50, 16, 15, 238, 238, 255, 17,
+  18, 34, 16, 15, 239, 238, 240, 1, 33, 33, 17, 255, 254, 254, 51, 240, 1, 34, 18, 16,
+  15, 238, 239, 255, 17, 34, 34, 16, 15, 237, 222, 224, 2, 51, 67, 33, 254, 187, 171, 206,
+  38, 68, 10, 15, 19, 23, 26
+};
+const byte narrowPulse[] PROGMEM = {
+  70, 121, 27, 26, 24, 20, 17, 11, 29, 114, 235, 168, 154, 222, 35, 85, 101, 49, 253, 186,
+  187, 222, 35, 103, 64, 8, 4, 101, 46, 144, 75, 245, 239, 236, 232, 230, 229, 230, 231, 234,
+  238, 242, 247, 27, 190, 20, 69, 83, 33, 254, 238, 222, 255, 17, 18, 33, 16, 15, 132, 63,
+  0, 16, 17, 17, 0, 240, 255, 240, 0, 1, 16, 16, 0, 15, 15, 15, 0, 1, 16, 16,
+  0, 15, 15, 15, 0, 16, 16, 16, 0, 15, 15, 15, 63, 0, 16, 16, 16, 0, 15, 15,
+  15, 0, 16, 16, 16, 0, 15, 15, 240, 0, 16, 16, 16, 0, 15, 15, 240, 0, 1, 17,
+  1, 0, 255, 255, 15, 2, 0, 16, 132, 26, 0, 255, 238, 255, 241, 18, 50, 34, 31, 237,
+  187, 204, 242, 80, 68, 9, 14, 18, 22, 25
+};
+const byte organ[] PROGMEM = {
+  72, 128, 11, 12, 11, 11, 10, 10, 9, 9, 18, 119, 101, 68, 34, 32, 16, 15, 15, 15,
+  0, 131, 17, 17, 1, 17, 1, 1, 0, 0, 255, 15, 136, 6, 15, 240, 240, 240, 131, 12,
+  239, 238, 237, 237, 221, 222, 208, 131, 15, 237, 222, 221, 237, 221, 204, 219, 203, 135, 36, 205,
+  206, 239, 0, 34, 52, 69, 86, 103, 102, 101, 84, 67, 34, 0, 254, 236, 220, 176, 135, 15,
+  203, 220, 205, 221, 237, 222, 221, 237, 131, 12, 237, 221, 222, 222, 238, 254, 240, 131, 6, 15,
+  15, 240, 240, 136, 17, 15, 240, 0, 1, 1, 1, 17, 1, 16, 131, 17, 240, 240, 240, 1,
+  2, 34, 68, 86, 119, 70, 9, 9, 10, 10, 11, 11, 12
+};
+const byte hollow[] PROGMEM = {
+  73, 128, 14, 15, 14, 14, 12, 12, 10, 9, 8, 40, 100, 50, 0, 237, 220, 204, 220, 221,
+  255, 0, 34, 51, 68, 69, 52, 34, 16, 253, 204, 169, 128, 70, 247, 247, 246, 246, 246, 247,
+  246, 12, 137, 155, 206, 241, 36, 87, 112, 72, 8, 10, 9, 10, 10, 10, 9, 9, 8, 40,
+  118, 68, 49, 15, 238, 205, 188, 204, 221, 238, 0, 17, 51, 67, 68, 67, 50, 0, 237, 202,
+  128, 79, 247, 246, 244, 244, 242, 242, 241, 242, 241, 241, 242, 242, 244, 244, 246, 247, 40, 138,
+  205, 224, 2, 51, 68, 67, 67, 49, 16, 14, 237, 220, 204, 189, 206, 239, 1, 52, 70, 112,
+  72, 8, 9, 9, 10, 10, 10, 9, 10, 8, 12, 119, 84, 33, 254, 203, 153, 128, 70, 246,
+  247, 246, 246, 246, 247, 247, 40, 137, 172, 205, 240, 18, 36, 53, 68, 67, 50, 32, 15, 253,
+  220, 220, 204, 221, 224, 2, 52, 96, 71, 8, 9, 10, 12, 12, 14, 14, 15
+};
+const byte soft[] PROGMEM = {
+  64, 128, 1, 18, 133, 14, 50, 34, 35, 34, 35, 34, 35, 32, 135, 1, 18, 135, 11, 50,
+  35, 34, 50, 50, 50, 131, 14, 18, 17, 1, 0, 240, 255, 239, 224, 131, 11, 222, 222, 222,
+  237, 238, 222, 135, 1, 254, 135, 14, 222, 238, 222, 238, 222, 238, 237, 224, 133, 1, 254, 134,
+  14, 222, 238, 237, 238, 237, 238, 237, 224, 135, 1, 254, 135, 11, 222, 237, 238, 222, 222, 222,
+  131, 14, 254, 255, 15, 0, 16, 17, 33, 32, 131, 11, 50, 50, 50, 35, 34, 50, 135, 1,
+  18, 135, 14, 50, 34, 50, 34, 50, 34, 35, 32, 133
+};
+
+// The bank of waves, as an array of pointers to the waves above.
+const byte * const bank[] = { sawtooth, square, narrowPulse, organ, hollow, soft };
+
+// Compress a wave, and print it out as an array to paste into a sketch.
+void printWave(const byte wave[]) {
+  byte packed[BUZZKILL_WAVE_PACKED_MAX];
+  word length = BuzzKillWave::compress(wave, packed);
+  Serial.print("const byte myWave[] PROGMEM = {");
+  for (word index=0; index<length; ++index) {
+    if (index > 0) Serial.print(",");
+    Serial.print(index % 20 == 0 ? "\n  " : " ");
+    Serial.print(packed[index]);
+  }
+  Serial.println("\n};");
+}
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Reset all registers to their default values, and set up voice 0 to play the custom wave, with a quick envelope.
+  buzzkill.resetRegisters();
+  buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 0, BUZZKILL_SHAPE_CUSTOM);
+  buzzkill.configureEnvelope(0, BUZZKILL_CURVE_NATURAL, 5, 100, 80, 100, 15, false);
+  buzzkill.enableVoice(0);
+
+  // To print a wave of your own, un-comment these lines, and change the first to build the wave you want.
+  //byte wave[256];
+  //BuzzKillWave::pulse(wave, 96, 20);
+  //Serial.begin(9600);
+  //printWave(wave);
+}
+
+void loop() {
+  // Play a short arpeggio with each wave in turn.
+  const byte notes[] = { 48, 55, 60, 64, 67, 72 };
+  for (byte waveNum=0; waveNum<6; ++waveNum) {
+    buzzkill.loadCustomWave(bank[waveNum]);
+    for (byte index=0; index<6; ++index) {
+      buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, notes[index]);
+      buzzkill.noteOn(0);
+      delay(150);
+      buzzkill.noteOff(0);
+      delay(30);
+    }
+    delay(300);
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ * This example uses the BuzzKill and BuzzKillWave classes from the BuzzKill library.
+ * It plays a fast arpeggio on one voice while changing the custom wave of another voice every second. The waves are
+ * sent in the background, 16 values at a time by poll(), so loop() never waits for a whole wave and the arpeggio
+ * keeps time. Note changes made while a wave is being sent wait in the queue until the wave is complete.
+ *
+ * PLEASE NOTE: This example uses SPI by default. If you have connected your BuzzKill board using I2C instead,
+ * see the comments within the setup() function for the appropriate changes.
+ *
+ * # Released under MIT License
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+
+#include <SPI.h>
+#include <Wire.h>
+#include <BuzzKill.h>
+#include <BuzzKillWave.h>
+
+// Create a BuzzKill object.
+BuzzKill buzzkill;
+
+// Two waves to switch between. They must not change while being sent, so each has its own array.
+byte waves[2][256];
+
+// Space for queued commands; this does not need to hold a whole wave.
+byte queue[64];
+
+// The arpeggio, as MIDI note numbers.
+const byte arpeggio[] = { 60, 64, 67, 72, 76, 72, 67, 64 };
+
+byte step = 0, current = 0;
+unsigned long lastNote = 0, lastWave = 0;
+
+void setup() {
+  // If using SPI, the following two lines should be un-commented. If using I2C, the lines should be commented out (or deleted).
+  SPI.begin();
+  buzzkill.beginSPI();
+
+  // If using I2C, the following two lines should be un-commented. If using SPI, the lines should be commented out (or deleted).
+  //Wire.begin();
+  //buzzkill.beginI2C();
+
+  // Build the waves ahead of time: a bright sawtooth and a hollow square wave.
+  BuzzKillWave::sawtooth(waves[0], 24);
+  BuzzKillWave::square(waves[1], 24);
+
+  // Reset all registers to their default values. Voice 0 holds a low note with the custom wave;
+  // voice 1 plays the arpeggio with a triangle wave and a short envelope.
+  buzzkill.resetRegisters();
+  buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 0, BUZZKILL_SHAPE_CUSTOM);
+  buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 0, 36);
+  buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 1, BUZZKILL_SHAPE_TRIANGLE);
+  buzzkill.configureEnvelope(1, BUZZKILL_CURVE_NATURAL, 5, 60, 0, 60, 15, false);
+  buzzkill.enableVoice(0);
+  buzzkill.enableVoice(1);
+
+  // Queue commands, and send custom waves in pieces of 16 values from then on.
+  buzzkill.beginQueue(queue, sizeof(queue));
+  buzzkill.setUploadChunk(16);
+  buzzkill.storeCustomWave(waves[0]);
+  buzzkill.noteOn(0);
+}
+
+void loop() {
+  unsigned long now = millis();
+
+  // Every 125 ms, play the next note of the arpeggio.
+  if (now - lastNote >= 125) {
+    lastNote = now;
+    buzzkill.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, 1, arpeggio[step]);
+    buzzkill.noteOn(1, false);
+    buzzkill.noteOn(1);
+    step = (step + 1) % sizeof(arpeggio);
+  }
+
+  // Every second, switch voice 0 to the other wave. This returns at once; the wave is sent by the poll() calls below.
+  if (now - lastWave >= 1000) {
+    lastWave = now;
+    current ^= 1;
+    buzzkill.storeCustomWave(waves[current]);
+  }
+
+  // Send queued commands and the next piece of any wave, spending no more than 300 us.
+  buzzkill.poll(300);
+}
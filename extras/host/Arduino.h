@@ -0,0 +1,89 @@
+/*
+ * Minimal Arduino core stand-in for building the BuzzKill library and example sketches on a desktop machine.
+ * Time is simulated: delay() advances a virtual clock instead of sleeping.
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_HOST_ARDUINO_H
+#define BUZZKILL_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef uint16_t word;
+typedef bool boolean;
+
+#define PROGMEM
+#define PGM_P const char *
+#define F(str) (str)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(const void * const *)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strncasecmp_PF(str, pstr, len) strncasecmp((str), (const char *)(pstr), (len))
+
+#define HIGH 1
+#define LED_BUILTIN 13
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define SS 10
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+class Print {
+public:
+    virtual size_t write(uint8_t val) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char str[]) { return print(str); }
+    virtual void flush() {}
+    size_t print(const char str[]);
+    size_t print(char val) { return write((uint8_t)val); }
+    size_t print(long val);
+    size_t print(unsigned long val);
+    size_t print(int val) { return print((long)val); }
+    size_t print(unsigned int val) { return print((unsigned long)val); }
+    size_t print(double val, int digits=2);
+    size_t println(const char str[]="");
+    size_t println(char val) { return print(val) + println(); }
+    size_t println(long val);
+    size_t println(unsigned long val);
+    size_t println(int val) { return println((long)val); }
+    size_t println(unsigned int val) { return println((unsigned long)val); }
+    size_t println(double val, int digits=2) { return print(val, digits) + println(); }
+    virtual ~Print() {}
+};
+
+class Stream: public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+};
+
+class HardwareSerial: public Stream {
+public:
+    size_t write(uint8_t val);
+    using Print::write;
+    void begin(unsigned long) {}
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // BUZZKILL_HOST_ARDUINO_H
@@ -0,0 +1,339 @@
+/*
+ * Software model of the BuzzKill board, for previewing sounds on a desktop machine.
+ *
+ * Rendering works on blocks of BUZZKILL_MODEL_BLOCK samples. Each stage (modulation oscillators, patch
+ * application, voice oscillators, envelopes, mixing) runs as a separate pass over plain float arrays, so the
+ * compiler can vectorize the arithmetic; only phase accumulation is inherently sequential.
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <math.h>
+#include <string.h>
+#include "BuzzKillModel.h"
+
+BuzzKillModel::BuzzKillModel(uint32_t sampleRate) {
+  _sampleRate = sampleRate;
+  for (int x = 0; x < 256; ++x) {
+    _tables[0][x] = lrintf(128 + 127 * sinf(2 * M_PI * x / 256));
+    _tables[1][x] = x;
+    _tables[2][x] = x < 128 ? x * 2 : 511 - x * 2;
+    _tables[3][x] = x < 128 ? 255 : 0;
+    _tables[4][x] = lrintf(powf(2, x / 32.0f) - 1);
+    _tables[5][x] = 128;
+    _tables[6][x] = 128;
+    _tables[7][x] = lrintf(255 * sinf(M_PI * x / 256));
+  }
+  memset(_oscs, 0, sizeof(_oscs));
+  memset(_envs, 0, sizeof(_envs));
+  _resetRegisters(0);
+}
+
+void BuzzKillModel::write(const uint8_t data[], size_t length) {
+  for (size_t x = 0; x < length; ++x) _writeByte(data[x]);
+}
+
+void BuzzKillModel::render(int16_t out[], size_t count) {
+  float block[BUZZKILL_MODEL_BLOCK];
+  while (count > 0) {
+    size_t size = count < BUZZKILL_MODEL_BLOCK ? count : BUZZKILL_MODEL_BLOCK;
+    _renderBlock(block, size);
+    for (size_t x = 0; x < size; ++x) {
+      float val = block[x] * 32767;
+      out[x] = val > 32767 ? 32767 : (val < -32768 ? -32768 : (int16_t)val);
+    }
+    out += size;
+    count -= size;
+  }
+}
+
+void BuzzKillModel::_writeByte(uint8_t data) {
+  switch (_state) {
+    case _CMD:
+      if (data < 244) {
+        _reg = data >> 2;
+        _remaining = data & 3;
+        _state = _remaining ? _REGS : _LENGTH;
+      }
+      else {
+        _cmd = data;
+        _argCount = 0;
+        if (data == 244 || data == 248) _remaining = 1;
+        else if (data == 245) _remaining = 8;
+        else if (data == 250) _remaining = 3;
+        else _remaining = 0;
+        if (data == 249) {
+          _waveIndex = 0;
+          _state = _WAVE;
+        }
+        else if (_remaining) _state = _ARGS;
+        else _execute();
+      }
+      break;
+    case _LENGTH:
+      if (data == 0) {
+        _resetRegisters(_reg);
+        _state = _CMD;
+      }
+      else {
+        _remaining = data;
+        _state = _REGS;
+      }
+      break;
+    case _REGS:
+      // Register 60 is the speech buffer, which keeps its position as phonemes are added
+      if (_reg < 60) _setRegister(_reg++, data);
+      if (--_remaining == 0) _state = _CMD;
+      break;
+    case _WAVE:
+      _tables[6][_waveIndex++] = data;
+      if (_waveIndex == 256) _state = _CMD;
+      break;
+    case _ARGS:
+      _args[_argCount++] = data;
+      if (--_remaining == 0) {
+        _execute();
+        _state = _CMD;
+      }
+      break;
+  }
+}
+
+void BuzzKillModel::_execute() {
+  if (_cmd == 248) {
+    for (uint8_t osc = 0; osc < 8; ++osc) if (_args[0] & (1 << osc)) {
+      _oscs[osc].phase = 0;
+      _oscs[osc].backward = false;
+    }
+  }
+}
+
+void BuzzKillModel::_setRegister(uint8_t reg, uint8_t value) {
+  uint8_t old = _regs[reg];
+  _regs[reg] = value;
+  if (reg >= 32 && reg < 48 && (reg & 3) == 2 && ((old ^ value) & 128)) _envGate((reg - 32) >> 2, value & 128);
+}
+
+void BuzzKillModel::_resetRegisters(uint8_t regStart) {
+  for (uint8_t reg = regStart; reg < 60; ++reg) {
+    if (reg < 32 || reg > 48) _regs[reg] = 0;
+    else if (reg == 48) _regs[reg] = 240;
+    else if ((reg & 3) == 2) _regs[reg] = 127;
+    else if ((reg & 3) == 3) _regs[reg] = 240;
+    else _regs[reg] = 0;
+  }
+  // Resetting an envelope silences it immediately
+  for (uint8_t env = 0; env < 4; ++env) if (regStart <= (env << 2) + 34) {
+    _envs[env].stage = _IDLE;
+    _envs[env].gate = false;
+    _envs[env].level = 0;
+  }
+}
+
+uint8_t BuzzKillModel::_nextRandom() {
+  _random ^= _random << 13;
+  _random ^= _random >> 17;
+  _random ^= _random << 5;
+  return _random >> 24;
+}
+
+float BuzzKillModel::_envTime(uint8_t range, uint8_t value) {
+  // Full-scale time in ms, the inverse of the library's time conversion
+  static const float base[4] = { 1, 123, 490, 1478 }, step[4] = { 8, 23, 62, 231 };
+  float time = base[range] + step[range] * value;
+  return time < 1 ? 1 : time;
+}
+
+void BuzzKillModel::_envGate(uint8_t envNum, bool gate) {
+  _Env &env = _envs[envNum];
+  if (gate == env.gate) return;
+  env.gate = gate;
+  env.stage = gate ? _ATTACK : _RELEASE;
+  env.start = env.level;
+  env.progress = 0;
+}
+
+float BuzzKillModel::_envCurve(float progress, bool inverted) {
+  // Inverted curves move quickly at first and then level off
+  return inverted ? 1 - (1 - progress) * (1 - progress) : progress;
+}
+
+float BuzzKillModel::_envAdvance(uint8_t envNum, size_t count) {
+  _Env &env = _envs[envNum];
+  const uint8_t *regs = &_regs[32 + (envNum << 2)];
+  bool invAttack = regs[0] & 0x40, invDecay = regs[0] & 0x80;
+  float sustain = (regs[2] & 127) / 127.0f;
+  float ms = count * 1000.0f / _sampleRate, duration;
+  switch (env.stage) {
+    case _ATTACK:
+      duration = _envTime(regs[0] & 3, regs[1] & 15) * (1 - env.start);
+      env.progress += duration > 0 ? ms / duration : 1;
+      if (env.progress < 1) {
+        env.level = env.start + (1 - env.start) * _envCurve(env.progress, invAttack);
+        break;
+      }
+      env.stage = _DECAY;
+      env.progress = 0;
+      env.level = 1;
+      break;
+    case _DECAY:
+      duration = _envTime((regs[0] >> 2) & 3, regs[1] >> 4) * (1 - sustain);
+      env.progress += duration > 0 ? ms / duration : 1;
+      if (env.progress < 1) {
+        env.level = 1 + (sustain - 1) * _envCurve(env.progress, invDecay);
+        break;
+      }
+      env.stage = _SUSTAIN;
+      env.level = sustain;
+      break;
+    case _SUSTAIN:
+      env.level = sustain;
+      break;
+    case _RELEASE:
+      duration = _envTime((regs[0] >> 4) & 3, regs[3] & 15) * env.start;
+      env.progress += duration > 0 ? ms / duration : 1;
+      if (env.progress < 1) {
+        env.level = env.start * (1 - _envCurve(env.progress, invDecay));
+        break;
+      }
+      env.stage = _IDLE;
+      env.level = 0;
+      break;
+    case _IDLE:
+      env.level = 0;
+      break;
+  }
+  return env.level;
+}
+
+void BuzzKillModel::_renderOsc(uint8_t oscNum, size_t count, const float inc[], const float mid[], const uint8_t sync[], float out[], uint8_t wrap[]) {
+  _Osc &osc = _oscs[oscNum];
+  uint8_t flags = _regs[(oscNum << 2) + 3], shape = flags >> 5, step = flags & 7;
+  bool halted = _regs[49] & (1 << oscNum), invert = flags & 8, reverse = flags & 16;
+  float phase[BUZZKILL_MODEL_BLOCK];
+
+  // Sequential pass: phase accumulation, sync and noise sampling
+  for (size_t x = 0; x < count; ++x) {
+    uint32_t prev = osc.phase, delta = (uint32_t)inc[x];
+    if (halted) {
+      osc.phase = 0;
+      wrap[x] = 0;
+    }
+    else {
+      if (sync[x] == 1) prev = osc.phase = 0;
+      else if (sync[x] == 2) osc.backward = !osc.backward;
+      osc.phase = osc.backward ? osc.phase - delta : osc.phase + delta;
+      wrap[x] = osc.backward ? osc.phase > prev : osc.phase < prev;
+      if (wrap[x]) osc.noise = _nextRandom();
+    }
+    phase[x] = osc.phase * (1.0f / 4294967296.0f);
+    out[x] = osc.noise;
+  }
+  if (shape == 5) return;
+
+  // Waveform pass: the first half of the shape spans up to the midpoint, the second half the remainder
+  const uint8_t *table = _tables[shape];
+  for (size_t x = 0; x < count; ++x) {
+    float p = reverse ? 1 - phase[x] : phase[x];
+    float m = mid[x] * (1.0f / 256);
+    float q = p < m ? 0.5f * p / m : 0.5f + 0.5f * (p - m) / (1 - m);
+    int index = (int)(q * 256);
+    out[x] = table[index < 0 ? 0 : (index > 255 ? 255 : index)];
+  }
+  if (invert) for (size_t x = 0; x < count; ++x) out[x] = 255 - out[x];
+  if (step) {
+    float size = 1 << step;
+    for (size_t x = 0; x < count; ++x) out[x] = floorf(out[x] / size) * size;
+  }
+}
+
+void BuzzKillModel::_renderBlock(float out[], size_t count) {
+  float mval[4][BUZZKILL_MODEL_BLOCK], inc[BUZZKILL_MODEL_BLOCK], mid[BUZZKILL_MODEL_BLOCK];
+  float amp[BUZZKILL_MODEL_BLOCK], voice[BUZZKILL_MODEL_BLOCK];
+  uint8_t mwrap[4][BUZZKILL_MODEL_BLOCK], sync[BUZZKILL_MODEL_BLOCK], wrap[BUZZKILL_MODEL_BLOCK];
+  // Phase increment per sample for one raw frequency unit (1/16 Hz)
+  const float unit = 268435456.0f / _sampleRate;
+
+  // Modulation oscillators are not patched, so they run at their register settings
+  memset(sync, 0, sizeof(sync));
+  for (uint8_t osc = 0; osc < 4; ++osc) {
+    float base = (_regs[osc << 2] | (_regs[(osc << 2) + 1] << 8)) * unit, midpoint = _regs[(osc << 2) + 2];
+    for (size_t x = 0; x < count; ++x) {
+      inc[x] = base;
+      mid[x] = midpoint < 1 ? 1 : midpoint;
+    }
+    _renderOsc(osc, count, inc, mid, sync, mval[osc], mwrap[osc]);
+  }
+
+  for (size_t x = 0; x < count; ++x) out[x] = 0;
+  for (uint8_t voiceNum = 0; voiceNum < 4; ++voiceNum) {
+    uint8_t osc = voiceNum + 4;
+    float base = (_regs[osc << 2] | (_regs[(osc << 2) + 1] << 8)) * unit, midpoint = _regs[(osc << 2) + 2];
+    bool ampLevel = false, patchGate = false;
+    for (size_t x = 0; x < count; ++x) {
+      inc[x] = base;
+      mid[x] = midpoint;
+      amp[x] = 1;
+      sync[x] = 0;
+    }
+
+    for (uint8_t slot = 0; slot < 5; ++slot) {
+      uint8_t patch = _regs[50 + (slot << 1)], param = _regs[51 + (slot << 1)];
+      uint8_t type = patch & 15, src = (patch >> 4) & 3, dest = patch >> 6;
+      float depth = param / 255.0f;
+      const float *mod = mval[src];
+      // The MULTI variants of types 4..8 apply to every voice
+      if (type >= 10 && type <= 14) type -= 6;
+      else if (dest != voiceNum) continue;
+      switch (type) {
+        case 1:
+          for (size_t x = 0; x < count; ++x) inc[x] *= 1 + (mod[x] - 128) * (1.0f / 128) * depth;
+          break;
+        case 2:
+          for (size_t x = 0; x < count; ++x) inc[x] += (mod[x] - 128) * (1.0f / 128) * param * 16 * unit;
+          break;
+        case 3:
+          for (size_t x = 0; x < count; ++x) mid[x] += (mod[x] - 128) * (1.0f / 256) * param;
+          break;
+        case 4:
+          for (size_t x = 0; x < count; ++x) amp[x] *= 1 - depth * (1 - mod[x] * (1.0f / 255));
+          break;
+        case 5:
+          for (size_t x = 0; x < count; ++x) amp[x] *= mod[x] * (1.0f / 255) * depth;
+          ampLevel = true;
+          break;
+        case 6:
+          if (mod[0] >= param) patchGate = true;
+          break;
+        case 7:
+          for (size_t x = 0; x < count; ++x) sync[x] |= mwrap[src][x];
+          break;
+        case 8:
+          for (size_t x = 0; x < count; ++x) if (mwrap[src][x]) sync[x] = 2;
+          break;
+        case 9:
+          for (size_t x = 0; x < count; ++x) amp[x] *= 1 - depth + depth * (mod[x] - 128) * (1.0f / 128);
+          break;
+      }
+    }
+    for (size_t x = 0; x < count; ++x) {
+      inc[x] = inc[x] < 0 ? 0 : (inc[x] > 4294967040.0f ? 4294967040.0f : inc[x]);
+      mid[x] = mid[x] < 1 ? 1 : (mid[x] > 255 ? 255 : mid[x]);
+    }
+    _renderOsc(osc, count, inc, mid, sync, voice, wrap);
+
+    // Envelope level is ramped across the block; AMPLEVEL patches take its place
+    const uint8_t *envRegs = &_regs[32 + (voiceNum << 2)];
+    _envGate(voiceNum, (envRegs[2] & 128) || patchGate);
+    float envStart = _envs[voiceNum].level, envEnd = _envAdvance(voiceNum, count);
+    if (ampLevel) envStart = envEnd = 1;
+    float gain = (envRegs[3] >> 4) / 15.0f * ((_regs[48] & (1 << voiceNum)) ? 1 : 0);
+    if (gain == 0) continue;
+    float slope = (envEnd - envStart) / count;
+    for (size_t x = 0; x < count; ++x) out[x] += (voice[x] - 128) * (1.0f / 128) * amp[x] * (envStart + slope * x) * gain;
+  }
+
+  // Four full-scale voices fit within the output range at maximum master volume
+  float master = (_regs[48] >> 4) / 15.0f * 0.25f;
+  for (size_t x = 0; x < count; ++x) out[x] *= master;
+}
@@ -0,0 +1,105 @@
+/*
+ * Software model of the BuzzKill board, for previewing sounds on a desktop machine.
+ * It consumes the same command byte stream the library sends over SPI/I2C, and renders 16-bit PCM audio.
+ *
+ * The model follows the register layout used by the library. Where the exact behavior of the board is not
+ * documented (waveform details, envelope curve shapes, patch depths), it uses a close approximation, so
+ * rendered audio is a preview rather than a bit-exact copy of the board output. Speech is not modeled.
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_MODEL_H
+#define BUZZKILL_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUZZKILL_MODEL_BLOCK 64
+
+class BuzzKillModel {
+public:
+    /**
+     * Constructor. All registers start at their reset values.
+     * @param sampleRate     (optional) The output sample rate in Hz; defaults to 44100
+     */
+    BuzzKillModel(uint32_t sampleRate=44100);
+
+
+    /**
+     * Feed command bytes to the model, exactly as sent to the board.
+     * Commands may be split across calls at any point.
+     * @param data           The command bytes
+     * @param length         Number of bytes
+     */
+    void write(const uint8_t data[],
+               size_t length);
+
+
+    /**
+     * Render audio samples, advancing the model's time accordingly.
+     * @param out            Array to receive the samples
+     * @param count          Number of samples to render
+     */
+    void render(int16_t out[],
+                size_t count);
+
+
+    /**
+     * Get the current contents of registers 0..59.
+     */
+    const uint8_t *registers() const { return _regs; }
+
+
+    /**
+     * Get the output sample rate.
+     */
+    uint32_t sampleRate() const { return _sampleRate; }
+
+private:
+    enum _decodeState: uint8_t { _CMD, _LENGTH, _REGS, _WAVE, _ARGS };
+    enum _envStage: uint8_t { _IDLE, _ATTACK, _DECAY, _SUSTAIN, _RELEASE };
+
+    struct _Osc {
+        uint32_t phase;
+        uint8_t noise;
+        bool backward;
+    };
+
+    struct _Env {
+        _envStage stage;
+        bool gate;
+        float level;
+        float start;
+        float progress;
+    };
+
+    uint32_t _sampleRate;
+    uint8_t _regs[60];
+    uint8_t _tables[8][256];
+    _Osc _oscs[8];
+    _Env _envs[4];
+    uint32_t _random=0x1234567;
+
+    _decodeState _state=_CMD;
+    uint8_t _cmd=0;
+    uint8_t _reg=0;
+    uint8_t _remaining=0;
+    uint16_t _waveIndex=0;
+    uint8_t _args[8];
+    uint8_t _argCount=0;
+
+    void _writeByte(uint8_t data);
+    void _setRegister(uint8_t reg, uint8_t value);
+    void _resetRegisters(uint8_t regStart);
+    void _execute();
+    uint8_t _nextRandom();
+    float _envTime(uint8_t range, uint8_t value);
+    void _envGate(uint8_t envNum, bool gate);
+    float _envCurve(float progress, bool inverted);
+    float _envAdvance(uint8_t envNum, size_t count);
+    void _renderOsc(uint8_t oscNum, size_t count, const float inc[], const float mid[], const uint8_t sync[], float out[], uint8_t wrap[]);
+    void _renderBlock(float out[], size_t count);
+};
+
+#endif // BUZZKILL_MODEL_H
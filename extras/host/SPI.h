@@ -0,0 +1,37 @@
+/*
+ * SPI library stand-in for desktop builds. Records every transaction for the bus report.
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_HOST_SPI_H
+#define BUZZKILL_HOST_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0c
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock, uint8_t, uint8_t) : clock(clock) {}
+    SPISettings() : clock(4000000) {}
+    uint32_t clock;
+};
+
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings settings);
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data);
+    void transfer(void *buf, size_t count);
+    uint32_t clock=4000000;
+};
+
+extern SPIClass SPI;
+
+#endif // BUZZKILL_HOST_SPI_H
@@ -0,0 +1,32 @@
+/*
+ * Wire library stand-in for desktop builds. Records every transaction for the bus report.
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_HOST_WIRE_H
+#define BUZZKILL_HOST_WIRE_H
+
+#include <Arduino.h>
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+
+class TwoWire {
+public:
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t speed) { clock = speed; }
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+    uint8_t endTransmission(bool sendStop=true);
+    uint32_t clock=100000;
+private:
+    size_t _count=0;
+};
+
+extern TwoWire Wire;
+
+#endif // BUZZKILL_HOST_WIRE_H
@@ -0,0 +1,45 @@
+#!/bin/sh
+#
+# Build an example sketch against the desktop stand-ins and report the bus traffic it generates.
+#
+# Usage: bus_report.sh [--i2c] [-v] [-w <file.wav>] [-r <rate>] <sketch.ino>...
+#   --i2c   Switch the sketch to I2C, by swapping the SPI/I2C lines in its setup() as its comments describe
+#   -v      List every transaction
+#   -w      Also render the sketch's audio with BuzzKillModel, saving it as a WAV file (use with one sketch)
+#   -r      Sample rate for the WAV file, default 44100
+#   -t      Run loop() repeatedly for this many (simulated) seconds, instead of once
+#
+# Set CXX to choose the compiler (default g++).
+
+HOST=$(cd "$(dirname "$0")" && pwd)
+SRC="$HOST/../../src"
+CXX=${CXX:-g++}
+I2C=0
+OPTIONS=
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+while [ $# -gt 0 ]; do
+  arg=$1
+  shift
+  case "$arg" in
+    --i2c) I2C=1 ;;
+    -v) OPTIONS="$OPTIONS -v" ;;
+    -w|-r|-t) OPTIONS="$OPTIONS $arg $1"; shift ;;
+    *)
+      name=$(basename "$arg" .ino)
+      {
+        echo '#include <Arduino.h>'
+        if [ $I2C = 1 ]; then
+          sed -e 's|^\(  *\)SPI\.begin();|\1//SPI.begin();|' -e 's|^\(  *\)\(buzzkill[0-9]*\)\.beginSPI(|\1//\2.beginSPI(|' \
+              -e 's|^\(  *\)//Wire\.begin();|\1Wire.begin();|' -e 's|^\(  *\)//\(buzzkill[0-9]*\)\.beginI2C(|\1\2.beginI2C(|' "$arg"
+        else
+          cat "$arg"
+        fi
+      } > "$TMP/$name.cpp"
+      $CXX -std=gnu++11 -O2 -I"$HOST" -I"$SRC" "$TMP/$name.cpp" "$SRC"/*.cpp "$HOST/host.cpp" "$HOST/BuzzKillModel.cpp" -o "$TMP/$name" || exit 1
+      if [ $I2C = 1 ]; then echo "$name (I2C):"; else echo "$name (SPI):"; fi
+      "$TMP/$name" $OPTIONS
+      ;;
+  esac
+done
@@ -0,0 +1,254 @@
+/*
+ * Desktop runner for BuzzKill sketches. Runs setup() and one pass of loop() against the stand-in SPI and Wire
+ * libraries, then reports the bus traffic generated, grouped into segments separated by delay() calls.
+ * Optionally, the traffic is also fed to BuzzKillModel and the resulting audio is saved as a WAV file.
+ *
+ * The wire time estimate uses the configured bus clock plus fixed per-transaction costs, which are based on
+ * a 16 MHz AVR and should be treated as approximate.
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include "BuzzKillModel.h"
+
+// Software overhead per SPI transaction: SS toggling with digitalWrite(), and beginTransaction()/endTransaction()
+#define HOST_SPI_SELECT_US 7.0
+#define HOST_SPI_TRANSACTION_US 1.5
+
+// Bit times per I2C transaction beyond the data bytes: START, address byte with ACK, STOP or repeated START
+#define HOST_I2C_FRAME_BITS 11
+
+// Time assumed for one pass of loop() that does not otherwise advance the clock, when running for a set time
+#define HOST_LOOP_US 50
+
+// Time assumed for one pass of a loop that waits by reading the clock, i.e. between two reads with nothing else in between
+#define HOST_WAIT_US 4
+
+struct HostStats {
+  unsigned long transactions;
+  unsigned long bytes;
+  double wireMicros;
+};
+
+HardwareSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+
+static double _clock = 0;
+static double _lastRead = -1;
+static bool _verbose = false;
+static HostStats _segment = { 0, 0, 0 }, _total = { 0, 0, 0 };
+static double _segmentStart = 0;
+static unsigned _segmentNum = 0;
+static bool _spiSelected = false;
+static uint8_t _spiPin = 0;
+static unsigned long _frameBytes = 0;
+static byte _preview[8];
+static BuzzKillModel *_model = nullptr;
+static std::vector<byte> _frame;
+static std::vector<int16_t> _audio;
+
+static void _renderTo(double micros) {
+  if (!_model) return;
+  size_t target = (size_t)(micros * _model->sampleRate() / 1e6);
+  if (target <= _audio.size()) return;
+  size_t start = _audio.size();
+  _audio.resize(target);
+  _model->render(&_audio[start], target - start);
+}
+
+static bool _saveWav(const char path[]) {
+  FILE *file = fopen(path, "wb");
+  if (!file) return false;
+  uint32_t rate = _model->sampleRate(), dataSize = _audio.size() * 2;
+  uint32_t header[] = { 0x46464952, 36 + dataSize, 0x45564157, 0x20746d66, 16, 0x00010001, rate, rate * 2, 0x00100002, 0x61746164, dataSize };
+  fwrite(header, 1, sizeof(header), file);
+  fwrite(_audio.data(), 2, _audio.size(), file);
+  fclose(file);
+  return true;
+}
+
+static void _record(const char bus[], unsigned long bytes, double wireMicros) {
+  if (_model) {
+    _renderTo(_clock);
+    _model->write(_frame.data(), _frame.size());
+  }
+  _segment.transactions++;
+  _segment.bytes += bytes;
+  _segment.wireMicros += wireMicros;
+  _clock += wireMicros;
+  if (!_verbose) return;
+  printf("    %s %4lu bytes %8.1f us  ", bus, bytes, wireMicros);
+  for (unsigned long x = 0; x < bytes && x < sizeof(_preview); ++x) printf(" %02x", _preview[x]);
+  printf(bytes > sizeof(_preview) ? " ...\n" : "\n");
+}
+
+static void _endSegment() {
+  if (_segment.transactions > 0) {
+    printf("  segment %-3u at %9.1f ms: %5lu transactions %6lu bytes %10.1f us on the wire\n",
+       ++_segmentNum, _segmentStart / 1000, _segment.transactions, _segment.bytes, _segment.wireMicros);
+    _total.transactions += _segment.transactions;
+    _total.bytes += _segment.bytes;
+    _total.wireMicros += _segment.wireMicros;
+  }
+  _segment = { 0, 0, 0 };
+  _segmentStart = _clock;
+}
+
+static void _capture(byte data) {
+  if (_model) _frame.push_back(data);
+  if (_frameBytes < sizeof(_preview)) _preview[_frameBytes] = data;
+  ++_frameBytes;
+}
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  // Any pin may be the select line, so a frame starts when a pin goes low, and ends when the same pin goes high.
+  // Until data is transferred, another pin going low takes over; frames without data (e.g. an LED) are not recorded.
+  if (val == LOW && (!_spiSelected || _frameBytes == 0)) {
+    _spiSelected = true;
+    _spiPin = pin;
+    _frameBytes = 0;
+    _frame.clear();
+  }
+  else if (val == HIGH && _spiSelected && pin == _spiPin) {
+    _spiSelected = false;
+    if (_frameBytes > 0) _record("SPI", _frameBytes, _frameBytes * 8 * 1e6 / SPI.clock + HOST_SPI_SELECT_US + HOST_SPI_TRANSACTION_US);
+  }
+}
+
+static void _readClock() {
+  if (_clock == _lastRead) {
+    _clock += HOST_WAIT_US;
+    _renderTo(_clock);
+  }
+  _lastRead = _clock;
+}
+
+unsigned long micros() { _readClock(); return (unsigned long)_clock; }
+unsigned long millis() { _readClock(); return (unsigned long)(_clock / 1000); }
+
+void delay(unsigned long ms) {
+  _endSegment();
+  _clock += ms * 1000.0;
+  _renderTo(_clock);
+  _segmentStart = _clock;
+}
+
+void delayMicroseconds(unsigned int us) {
+  _clock += us;
+  _renderTo(_clock);
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t count = 0;
+  while (size--) count += write(*buffer++);
+  return count;
+}
+
+size_t Print::print(const char str[]) { return write((const uint8_t *)str, strlen(str)); }
+
+size_t Print::print(long val) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%ld", val);
+  return print(buf);
+}
+
+size_t Print::print(unsigned long val) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%lu", val);
+  return print(buf);
+}
+
+size_t Print::print(double val, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, val);
+  return print(buf);
+}
+
+size_t Print::println(const char str[]) { return print(str) + print("\r\n"); }
+size_t Print::println(long val) { return print(val) + println(); }
+size_t Print::println(unsigned long val) { return print(val) + println(); }
+
+size_t HardwareSerial::write(uint8_t val) { return fwrite(&val, 1, 1, stdout); }
+
+void SPIClass::beginTransaction(SPISettings settings) { clock = settings.clock; }
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  _capture(data);
+  return 0xff;
+}
+
+void SPIClass::transfer(void *buf, size_t count) {
+  // Like real SPI hardware, the buffer is overwritten with the bytes received
+  for (size_t x = 0; x < count; ++x) {
+    _capture(((byte *)buf)[x]);
+    ((byte *)buf)[x] = 0xff;
+  }
+}
+
+void TwoWire::beginTransmission(uint8_t) {
+  _count = 0;
+  _frameBytes = 0;
+  _frame.clear();
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (_count >= BUFFER_LENGTH) return 0;
+  ++_count;
+  _capture(data);
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t count;
+  for (count = 0; count < quantity && write(data[count]); ++count);
+  return count;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  _record("I2C", _count, (_count * 9 + HOST_I2C_FRAME_BITS) * 1e6 / clock);
+  return 0;
+}
+
+void setup();
+void loop();
+
+int main(int argc, char *argv[]) {
+  const char *wavPath = nullptr;
+  uint32_t rate = 44100;
+  double runMicros = 0;
+  for (int arg = 1; arg < argc; ++arg) {
+    if (!strcmp(argv[arg], "-v")) _verbose = true;
+    else if (!strcmp(argv[arg], "-w") && arg + 1 < argc) wavPath = argv[++arg];
+    else if (!strcmp(argv[arg], "-r") && arg + 1 < argc) rate = atol(argv[++arg]);
+    else if (!strcmp(argv[arg], "-t") && arg + 1 < argc) runMicros = atof(argv[++arg]) * 1e6;
+  }
+  if (wavPath) _model = new BuzzKillModel(rate);
+  setup();
+  do {
+    double before = _clock;
+    loop();
+    if (_clock == before) {
+      _clock += HOST_LOOP_US;
+      _renderTo(_clock);
+    }
+  } while (_clock < runMicros);
+  _endSegment();
+  printf("  total: %lu transactions, %lu bytes, %.1f us on the wire\n", _total.transactions, _total.bytes, _total.wireMicros);
+  if (wavPath) {
+    if (!_saveWav(wavPath)) {
+      printf("  could not write %s\n", wavPath);
+      return 1;
+    }
+    printf("  audio: %.1f s written to %s\n", (double)_audio.size() / rate, wavPath);
+  }
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Decoder for BuzzKill trace dumps. Reads the binary output of BuzzKill::dumpTrace(), e.g. captured from the serial
+ * port, and prints one line per recorded transfer. Any other text in the capture, such as messages printed by the
+ * sketch between dumps, is skipped. Commands that were queued are matched with their later transfer, in order for
+ * each board, and the time between the call and the end of the transfer is shown as the latency.
+ *
+ * Build: g++ -std=gnu++11 -DBUZZKILL_TRACE -Iextras/host -Isrc extras/host/trace_decode.cpp -o trace_decode
+ * Usage: trace_decode [capture file]      (reads standard input if no file is given)
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <deque>
+#include <map>
+#include <vector>
+#include <BuzzKill.h>
+
+// Names of the public methods, in the order of buzzkill_trace_api_t
+static const char *_apiNames[] = {
+  "-", "setFrequency", "setNoteFrequency", "setMidpoint", "setShape", "setInvert", "setReverse", "setStep",
+  "configureOscillator", "restartOscillators", "haltOscillators", "setCurve", "setAttack", "setDecay", "setSustain",
+  "setRelease", "setMixVolume", "noteOn", "noteOff", "configureEnvelope", "addPatch", "removePatch", "clearPatches",
+  "addSpeech", "clearSpeechBuffer", "setSpeechSpeed", "setSpeechFactors", "prepareSpeechMode", "startSpeaking",
+  "stopSpeaking", "enableVoice", "setMasterVolume", "resetRegisters", "setRegister", "writeRegisters", "boardSleep",
+  "boardWake", "storeCustomWave", "loadCustomWave", "changeI2CAddress", "poll", "flush", "restoreSnapshot",
+  "loadPreset", "commitBatch", "setRouting"
+};
+static_assert(sizeof(_apiNames) / sizeof(_apiNames[0]) == BUZZKILL_TRACE_API_COUNT, "_apiNames does not match buzzkill_trace_api_t");
+
+static void _describe(const buzzkill_trace_t &record, char text[], size_t size) {
+  byte command = record.command, length = record.length;
+  if (command < 60 && length == 0) snprintf(text, size, "reset registers %u..59", command);
+  else if (command < 60 && length == 1) snprintf(text, size, "register %u", command);
+  else if (command < 60) snprintf(text, size, "registers %u..%u", command, command + length - 1);
+  else if (command == 60) snprintf(text, size, length ? "speech, %u phonemes" : "clear speech", length);
+  else if (command == 244) snprintf(text, size, "speech speed");
+  else if (command == 245) snprintf(text, size, "speech factors");
+  else if (command == 246) snprintf(text, size, "stop speaking");
+  else if (command == 247) snprintf(text, size, "start speaking");
+  else if (command == 248) snprintf(text, size, "restart oscillators");
+  else if (command == 249) snprintf(text, size, length ? "custom wave, %u values" : "custom wave (waiting)", length);
+  else if (command == 250) snprintf(text, size, "change I2C address");
+  else if (command == 251) snprintf(text, size, "sleep");
+  else if (command == 255) snprintf(text, size, "data, %u bytes", length);
+  else snprintf(text, size, "command %u, %u bytes", command, length);
+}
+
+int main(int argc, char *argv[]) {
+  FILE *file = (argc > 1) ? fopen(argv[1], "rb") : stdin;
+  if (!file) {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<byte> input;
+  int c;
+  while ((c = fgetc(file)) != EOF) input.push_back((byte)c);
+
+  // Queued commands waiting to be matched with their transfer, for each board
+  std::map<int, std::deque<buzzkill_trace_t> > waiting;
+  unsigned dumps = 0;
+  bool haveFirst = false;
+  uint32_t first = 0;
+  for (size_t pos = 0; pos + 7 <= input.size(); ) {
+    if (memcmp(&input[pos], "BKT", 3) || input[pos + 3] != 1) {
+      ++pos;
+      continue;
+    }
+    byte count = input[pos + 4];
+    unsigned lost = input[pos + 5] | (input[pos + 6] << 8);
+    pos += 7;
+    if (pos + count * 13 > input.size()) {
+      printf("dump %u is incomplete\n", dumps + 1);
+      break;
+    }
+    printf("dump %u: %u transfers", ++dumps, count);
+    if (lost) {
+      printf(", %u older transfers lost", lost);
+      // Queued commands can no longer be matched reliably
+      waiting.clear();
+    }
+    printf("\n%12s %8s %9s  %-20s %-26s %s\n", "start us", "took us", "board", "method", "transfer", "latency us");
+    for (byte index = 0; index < count; ++index, pos += 13) {
+      buzzkill_trace_t record;
+      record.start = input[pos] | (input[pos + 1] << 8) | ((uint32_t)input[pos + 2] << 16) | ((uint32_t)input[pos + 3] << 24);
+      record.end = input[pos + 4] | (input[pos + 5] << 8) | ((uint32_t)input[pos + 6] << 16) | ((uint32_t)input[pos + 7] << 24);
+      record.api = input[pos + 8];
+      record.command = input[pos + 9];
+      record.length = input[pos + 10];
+      record.device = input[pos + 11];
+      record.flags = input[pos + 12];
+      if (!haveFirst) {
+        first = record.start;
+        haveFirst = true;
+      }
+      char board[16], transfer[40], latency[16] = "";
+      if (record.flags & BUZZKILL_TRACE_I2C) snprintf(board, sizeof(board), "I2C 0x%02x", record.device);
+      else snprintf(board, sizeof(board), "SPI %u", record.device);
+      _describe(record, transfer, sizeof(transfer));
+      std::deque<buzzkill_trace_t> &queue = waiting[record.device | ((record.flags & BUZZKILL_TRACE_I2C) << 8)];
+      if (record.flags & BUZZKILL_TRACE_QUEUED) {
+        queue.push_back(record);
+        strcat(transfer, " (queued)");
+      }
+      else if (!queue.empty() && queue.front().command == record.command && (int32_t)(record.start - queue.front().start) >= 0) {
+        snprintf(latency, sizeof(latency), "%lu", (unsigned long)(uint32_t)(record.end - queue.front().start));
+        queue.pop_front();
+      }
+      const char *api = (record.api < BUZZKILL_TRACE_API_COUNT) ? _apiNames[record.api] : "?";
+      printf("%12lu %8lu %9s  %-20s %-26s %s\n", (unsigned long)(uint32_t)(record.start - first),
+             (unsigned long)(uint32_t)(record.end - record.start), board, api, transfer, latency);
+    }
+  }
+  if (dumps == 0) printf("no trace dumps found\n");
+  if (file != stdin) fclose(file);
+  return 0;
+}
@@ -1,174 +1,268 @@
 #include <BuzzKill.h>
 
+// Semitone ratios and note frequencies, evaluated by the compiler only
+static constexpr double _semitones(byte count) {
+  return count == 0 ? 1.0 : 1.0594630943592953 * _semitones(count - 1);
+}
+
+static constexpr word _noteWord(byte index) {
+  return (word)(3520.0 * 16 * _semitones(index) / _semitones(9) + 0.5);
+}
+
+// Raw frequencies for the highest octave (MIDI notes 96..107); lower octaves are derived by shifting
+const word BuzzKill::_noteTable[12] PROGMEM = {
+  _noteWord(0), _noteWord(1), _noteWord(2), _noteWord(3), _noteWord(4), _noteWord(5),
+  _noteWord(6), _noteWord(7), _noteWord(8), _noteWord(9), _noteWord(10), _noteWord(11)
+};
+
 BuzzKill::BuzzKill() {
   _resetShadows(0);
 }
 
-void BuzzKill::beginSPI(byte pinSS=SS, SPIClass &spi=SPI) {
+void BuzzKill::beginSPI(byte pinSS, SPIClass &spi, uint32_t speed) {
   _spiSS = pinSS;
   _spi = &spi;
+  _i2c = nullptr;
+  _transport = this;
+  _transportOps = &_spiOps;
+  setSPISpeed(speed);
+}
+
+void BuzzKill::setSPISpeed(uint32_t speed) {
+  _spiSettings = SPISettings(speed, MSBFIRST, SPI_MODE0);
+}
+
+void BuzzKill::beginSession() {
+  if (_transportOps && _sessionDepth++ == 0) _transportOps->session(_transport, true);
+}
+
+void BuzzKill::endSession() {
+  if (_sessionDepth && --_sessionDepth == 0) _transportOps->session(_transport, false);
 }
 
-void BuzzKill::beginI2C(byte address=10, TwoWire &wire=Wire) {
+void BuzzKill::_joinSession(bool begin) {
+  // Enter or leave a session that another object on the same bus has opened, without opening or closing it here
+  if (begin) ++_sessionDepth;
+  else if (_sessionDepth) --_sessionDepth;
+}
+
+void BuzzKill::beginI2C(byte address, TwoWire &wire) {
   _i2cAddr = address;
   _i2c = &wire;
+  _spi = nullptr;
+  _transport = this;
+  _transportOps = &_i2cOps;
+}
+
+void BuzzKill::setI2CBufferSize(word size) {
+  if (size < 4) return;
+  _i2cBuffer = size;
 }
 
-void BuzzKill::setFrequency(buzzkill_osctype_t oscType, byte oscNum, double frequency) {
+void BuzzKill::setFrequency(buzzkill_osctype_t oscType, byte oscNum, buzzkill_freq_t frequency) {
+  BUZZKILL_TRACE_API(SET_FREQUENCY);
   if (oscNum>3  || frequency>=4096) return;
   word wfreq = frequency * 16;
-  byte arr[2] = { wfreq & 255, wfreq >> 8 };
-  _send(oscType+(oscNum<<2), arr, 2);
+  byte arr[2] = { (byte)(wfreq & 255), (byte)(wfreq >> 8) };
+  _update(oscType+(oscNum<<2), arr, 2);
+}
+
+void BuzzKill::setFrequencyRaw(buzzkill_osctype_t oscType, byte oscNum, word freq16) {
+  BUZZKILL_TRACE_API(SET_FREQUENCY);
+  if (oscNum>3) return;
+  byte arr[2] = { (byte)(freq16 & 255), (byte)(freq16 >> 8) };
+  _update(oscType+(oscNum<<2), arr, 2);
+}
+
+void BuzzKill::setNoteFrequency(buzzkill_osctype_t oscType, byte oscNum, byte note, int cents) {
+  BUZZKILL_TRACE_API(SET_NOTE_FREQUENCY);
+  word freq16 = noteToFrequency(note, cents);
+  if (freq16 == 0) return;
+  setFrequencyRaw(oscType, oscNum, freq16);
+}
+
+word BuzzKill::noteToFrequency(byte note, int cents) {
+  long total = note * 100L + cents;
+  if (total < 0 || total > 10700) return 0;
+  byte index = total / 100, frac = total % 100;
+  // Scale from the top octave down to the note's octave, keeping 8 extra bits of precision
+  unsigned long lower = (unsigned long)pgm_read_word(&_noteTable[index % 12]) << (index / 12);
+  if (frac) {
+    unsigned long upper = (unsigned long)pgm_read_word(&_noteTable[(index+1) % 12]) << ((index+1) / 12);
+    lower += (upper - lower) * frac / 100;
+  }
+  return (lower + 128) >> 8;
 }
 
 void BuzzKill::setMidpoint(buzzkill_osctype_t oscType, byte oscNum, byte midpoint) {
+  BUZZKILL_TRACE_API(SET_MIDPOINT);
   if (oscNum>3) return;
-  _send(oscType+(oscNum<<2)+2, &midpoint, 1);
+  _update(oscType+(oscNum<<2)+2, &midpoint, 1);
 }
 
 void BuzzKill::setShape(buzzkill_osctype_t oscType, byte oscNum, buzzkill_shape_t shape) {
+  BUZZKILL_TRACE_API(SET_SHAPE);
   if (oscNum>3) return;
-  byte index = (oscType>>2) + oscNum;
-  _shadows[index] = (_shadows[index] & 31) | shape;
-  _send(oscType+(oscNum<<2)+3, &_shadows[index], 1);
+  byte reg = oscType+(oscNum<<2)+3;
+  byte val = (_shadows[reg] & 31) | shape;
+  _update(reg, &val, 1);
 }
 
 void BuzzKill::setInvert(buzzkill_osctype_t oscType, byte oscNum, bool invert) {
+  BUZZKILL_TRACE_API(SET_INVERT);
   if (oscNum>3) return;
-  byte index = (oscType>>2) + oscNum;
-  _shadows[index] = (_shadows[index] & (~8)) | (invert?8:0);
-  _send(oscType+(oscNum<<2)+3, &_shadows[index], 1);
+  byte reg = oscType+(oscNum<<2)+3;
+  byte val = (_shadows[reg] & (~8)) | (invert?8:0);
+  _update(reg, &val, 1);
 }
 
 void BuzzKill::setReverse(buzzkill_osctype_t oscType, byte oscNum, bool reverse) {
+  BUZZKILL_TRACE_API(SET_REVERSE);
   if (oscNum>3) return;
-  byte index = (oscType>>2) + oscNum;
-  _shadows[index] = (_shadows[index] & (~16)) | (reverse?16:0);
-  _send(oscType+(oscNum<<2)+3, &_shadows[index], 1);
+  byte reg = oscType+(oscNum<<2)+3;
+  byte val = (_shadows[reg] & (~16)) | (reverse?16:0);
+  _update(reg, &val, 1);
 }
 
 void BuzzKill::setStep(buzzkill_osctype_t oscType, byte oscNum, byte step) {
+  BUZZKILL_TRACE_API(SET_STEP);
   if (oscNum>3) return;
-  byte index = (oscType>>2) + oscNum;
-  _shadows[index] = (_shadows[index] & (~7)) | step;
-  _send(oscType+(oscNum<<2)+3, &_shadows[index], 1);
+  byte reg = oscType+(oscNum<<2)+3;
+  byte val = (_shadows[reg] & (~7)) | step;
+  _update(reg, &val, 1);
 }
 
-void BuzzKill::configureOscillator(buzzkill_osctype_t oscType, byte oscNum, double frequency, buzzkill_shape_t shape, byte midpoint=128, bool invert=false, bool reverse=false, byte step=0) {
+void BuzzKill::configureOscillator(buzzkill_osctype_t oscType, byte oscNum, buzzkill_freq_t frequency, buzzkill_shape_t shape, byte midpoint, bool invert, bool reverse, byte step) {
+  BUZZKILL_TRACE_API(CONFIGURE_OSCILLATOR);
   if (oscNum>3  || step>7 || frequency>=4096) return;
   word wfreq = frequency * 16;
-  byte arr[4] = { wfreq & 255, wfreq >> 8, midpoint, shape | (reverse?16:0) | (invert?8:0) | step };
-  _shadows[(oscType>>2)+oscNum]=arr[3];
-  _send(oscType+(oscNum<<2), arr, 4);
+  byte arr[4] = { (byte)(wfreq & 255), (byte)(wfreq >> 8), midpoint, (byte)(shape | (reverse?16:0) | (invert?8:0) | step) };
+  _update(oscType+(oscNum<<2), arr, 4);
 }
 
 void BuzzKill::restartOscillators(byte restartMask) {
-  _send(248, &restartMask, 1);
+  BUZZKILL_TRACE_API(RESTART_OSCILLATORS);
+  _command(248, &restartMask, 1);
 }
 
 void BuzzKill::haltOscillators(byte haltMask) {
-  _send(49, &haltMask, 1);
+  BUZZKILL_TRACE_API(HALT_OSCILLATORS);
+  // Halting acts when written, like a command, so a repeat of the same mask is still sent
+  _command(49, &haltMask, 1);
+  _shadows[49] = haltMask;
+  _setBits(_known, 49, 1, true);
 }
 
 void BuzzKill::setCurve(byte envNum, buzzkill_curve_t curveType) {
+  BUZZKILL_TRACE_API(SET_CURVE);
   if (envNum > 3) return;
-  byte index = (envNum<<2) + 8;
-  _shadows[index] = (_shadows[index] & 0b00111111) | curveType;
-  _send((envNum<<2)+32, &_shadows[index], 1);
+  byte reg = (envNum<<2) + 32;
+  byte val = (_shadows[reg] & 0b00111111) | curveType;
+  _update(reg, &val, 1);
 }
 
 void BuzzKill::setAttack(byte envNum, byte attackRange, byte attackVal) {
+  BUZZKILL_TRACE_API(SET_ATTACK);
   if (envNum>3 || attackRange>3 || attackVal>15) return;
-  byte index = (envNum<<2) + 8;
-  _shadows[index] = (_shadows[index] & 0b11111100) | attackRange;
-  _shadows[index+1] = (_shadows[index+1] & 0b11110000) | attackVal;
-  _send((envNum<<2)+32, &_shadows[index], 2);
+  byte reg = (envNum<<2) + 32;
+  byte arr[2] = { (byte)((_shadows[reg] & 0b11111100) | attackRange), (byte)((_shadows[reg+1] & 0b11110000) | attackVal) };
+  _update(reg, arr, 2);
 }
 
 void BuzzKill::setAttack(byte envNum, word attackTime) {
+  BUZZKILL_TRACE_API(SET_ATTACK);
   byte attackRange, attackVal;
   _timeConvert(attackTime, attackRange, attackVal);
   setAttack(envNum, attackRange, attackVal);
 }
 
 void BuzzKill::setDecay(byte envNum, byte decayRange, byte decayVal) {
+  BUZZKILL_TRACE_API(SET_DECAY);
   if (envNum > 3 || decayRange > 3 || decayVal > 15) return;
-  byte index = (envNum<<2) + 8;
-  _shadows[index] = (_shadows[index] & 0b11110011) | (decayRange<<2);
-  _shadows[index+1] = (_shadows[index+1] & 0b00001111) | (decayVal<<4);
-  _send((envNum<<2)+32, &_shadows[index], 2);
+  byte reg = (envNum<<2) + 32;
+  byte arr[2] = { (byte)((_shadows[reg] & 0b11110011) | (decayRange<<2)), (byte)((_shadows[reg+1] & 0b00001111) | (decayVal<<4)) };
+  _update(reg, arr, 2);
 }
 
 void BuzzKill::setDecay(byte envNum, word decayTime) {
+  BUZZKILL_TRACE_API(SET_DECAY);
   byte decayRange, decayVal;
   _timeConvert(decayTime, decayRange, decayVal);
   setDecay(envNum, decayRange, decayVal);
 }
 
 void BuzzKill::setSustain(byte envNum, byte sustain) {
+  BUZZKILL_TRACE_API(SET_SUSTAIN);
   if (envNum > 3 || sustain > 127) return;
-  byte index = (envNum<<2) + 10;
-  _shadows[index] = (_shadows[index] & 0b10000000) | sustain;
-  _send((envNum<<2)+34, &_shadows[index], 1);
+  byte reg = (envNum<<2) + 34;
+  byte val = (_shadows[reg] & 0b10000000) | sustain;
+  _update(reg, &val, 1);
 }
 
 void BuzzKill::setRelease(byte envNum, byte releaseRange, byte releaseVal) {
+  BUZZKILL_TRACE_API(SET_RELEASE);
   if (envNum > 3 || releaseRange > 3 || releaseVal > 15) return;
-  byte index = (envNum<<2) + 8;
-  _shadows[index] = (_shadows[index] & 0b11001111) | (releaseRange<<4);
-  _shadows[index+3] = (_shadows[index+3] & 0b11110000) | releaseVal;
-  _send((envNum<<2)+32, &_shadows[index], 1);
-  _send((envNum<<2)+35, &_shadows[index+3], 1);
+  byte reg = (envNum<<2) + 32;
+  byte val = (_shadows[reg] & 0b11001111) | (releaseRange<<4);
+  _update(reg, &val, 1);
+  val = (_shadows[reg+3] & 0b11110000) | releaseVal;
+  _update(reg+3, &val, 1);
 }
 
 void BuzzKill::setRelease(byte envNum, word releaseTime) {
+  BUZZKILL_TRACE_API(SET_RELEASE);
   byte releaseRange, releaseVal;
   _timeConvert(releaseTime, releaseRange, releaseVal);
   setRelease(envNum, releaseRange, releaseVal);
 }
 
 void BuzzKill::setMixVolume(byte envNum, byte mixVol) {
+  BUZZKILL_TRACE_API(SET_MIX_VOLUME);
   if (envNum > 3 || mixVol > 15) return;
-  byte index = (envNum<<2) + 11;
-  _shadows[index] = (_shadows[index] & 0b00001111) | (mixVol<<4);
-  _send((envNum<<2)+35, &_shadows[index], 1);
+  byte reg = (envNum<<2) + 35;
+  byte val = (_shadows[reg] & 0b00001111) | (mixVol<<4);
+  _update(reg, &val, 1);
 }
 
-void BuzzKill::noteOn(byte envNum, bool gate=true) {
+void BuzzKill::noteOn(byte envNum, bool gate) {
+  BUZZKILL_TRACE_API(NOTE_ON);
   if (envNum > 3) return;
-  byte index = (envNum<<2) + 10;
-  if (gate) _shadows[index] |= 128; else _shadows[index] &= (~128);
-  _send((envNum<<2)+34, &_shadows[index], 1);
+  byte reg = (envNum<<2) + 34;
+  byte val = gate ? (_shadows[reg] | 128) : (_shadows[reg] & (~128));
+  _update(reg, &val, 1);
 }
 
 void BuzzKill::noteOn(bool gate0, bool gate1, bool gate2, bool gate3) {
-  byte index;
+  BUZZKILL_TRACE_API(NOTE_ON);
+  byte reg, val;
   bool arr[] = { gate0, gate1, gate2, gate3 };
   for (byte x=0; x<4; ++x) {
-    index = (x<<2) + 10;
-    if (arr[x] && _shadows[index] < 128) {
-      _shadows[index] |= 128;
-      _send((x<<2)+34, &_shadows[index], 1);
+    reg = (x<<2) + 34;
+    if (arr[x] && _shadows[reg] < 128) {
+      val = _shadows[reg] | 128;
+      _update(reg, &val, 1);
     }
-    else if (!arr[x] && _shadows[index] > 127) {
-      _shadows[index] &= (~128);
-      _send((x<<2)+34, &_shadows[index], 1);
+    else if (!arr[x] && _shadows[reg] > 127) {
+      val = _shadows[reg] & (~128);
+      _update(reg, &val, 1);
     }
   }
 }
 
 void BuzzKill::noteOff(byte envNum) {
+  BUZZKILL_TRACE_API(NOTE_OFF);
   noteOn(envNum, false);
 }
 
 void BuzzKill::configureEnvelope(byte envNum, buzzkill_curve_t curveType, byte attackRange, byte attackVal, byte decayRange, byte decayVal, byte sustainLev, byte releaseRange, byte releaseVal, byte mixVol, bool noteOn) {
+  BUZZKILL_TRACE_API(CONFIGURE_ENVELOPE);
   if (envNum>3 || attackRange>3 || attackVal>15 || decayRange>3 || decayVal>15 || sustainLev>127 || releaseRange>3 || releaseVal>15 || mixVol>15) return;
-  byte arr[4] = { curveType | (releaseRange<<4) | (decayRange<<2) | attackRange, (decayVal<<4) | attackVal, (noteOn?128:0) | sustainLev, (mixVol<<4) | releaseVal };
-  for (byte x=0; x<4; ++x) _shadows[(envNum<<2)+8+x] = arr[x];
-  _send((envNum<<2)+32, arr, 4);
+  byte arr[4] = { (byte)(curveType | (releaseRange<<4) | (decayRange<<2) | attackRange), (byte)((decayVal<<4) | attackVal), (byte)((noteOn?128:0) | sustainLev), (byte)((mixVol<<4) | releaseVal) };
+  _update((envNum<<2)+32, arr, 4);
 }
 
 void BuzzKill::configureEnvelope(byte envNum, buzzkill_curve_t curveType, word attackTime, word decayTime, byte sustainLev, word releaseTime, byte mixVol, bool noteOn) {
+  BUZZKILL_TRACE_API(CONFIGURE_ENVELOPE);
   byte attackRange, attackVal, decayRange, decayVal, releaseRange, releaseVal;
   _timeConvert(attackTime, attackRange, attackVal);
   _timeConvert(decayTime, decayRange, decayVal);
@@ -177,37 +271,98 @@ void BuzzKill::configureEnvelope(byte envNum, buzzkill_curve_t curveType, word a
 }
 
 byte BuzzKill::addPatch(byte srcMod, byte destVoice, buzzkill_patch_t patchType, byte patchParam) {
+  BUZZKILL_TRACE_API(ADD_PATCH);
   if (srcMod > 3 || destVoice > 3 || patchType > 15) return 255;
   byte slot, arr[2];
-  for (slot=0; slot<5; ++slot) if ((_shadows[slot+25] & 0b00001111) == 0) break;
+  for (slot=0; slot<5; ++slot) if ((_shadows[(slot<<1)+50] & 0b00001111) == 0) break;
   if (slot > 4) return 255;
-  arr[0] = _shadows[slot+25] = (destVoice<<6) | (srcMod<<4) | patchType;
+  arr[0] = (destVoice<<6) | (srcMod<<4) | patchType;
   arr[1] = patchParam;
-  _send((slot<<1)+50, arr, 2);
+  _update((slot<<1)+50, arr, 2);
   return slot;
 }
 
 void BuzzKill::removePatch(byte patchSlot) {
+  BUZZKILL_TRACE_API(REMOVE_PATCH);
   if (patchSlot > 4) return;
-  _shadows[patchSlot+25] = 0;
-  _send((patchSlot<<1)+50, &_shadows[patchSlot+25], 1);
+  byte val = 0;
+  _update((patchSlot<<1)+50, &val, 1);
 }
 
 void BuzzKill::clearPatches() {
+  BUZZKILL_TRACE_API(CLEAR_PATCHES);
   resetRegisters(50);
 }
 
-void BuzzKill::addSpeechPhonemes(const byte phonemes[], byte length=0) {
+bool BuzzKill::setRouting(const buzzkill_route_t routes[], byte count) {
+  BUZZKILL_TRACE_API(SET_ROUTING);
+  if (count > 5) return false;
+  byte image[10], heads[5], index, slot, reg, used = 0, placed = 0;
+  for (index=0; index<count; ++index) {
+    const buzzkill_route_t &route = routes[index];
+    if (route.srcMod > 3 || route.destVoice > 3 || route.patchType == BUZZKILL_PATCH_NONE || route.patchType > 15) return false;
+    heads[index] = (route.destVoice<<6) | (route.srcMod<<4) | route.patchType;
+  }
+  // Match routes to slots in order of cost: slots holding the route already, then those needing only a new parameter,
+  // then slots holding patches no longer wanted (which would otherwise need clearing), then free slots
+  for (byte pass=0; pass<4; ++pass) {
+    for (index=0; index<count; ++index) {
+      if (placed & (1<<index)) continue;
+      for (slot=0; slot<5; ++slot) {
+        reg = (slot<<1)+50;
+        if (used & (1<<slot)) continue;
+        if (pass == 0 && _shadows[reg] == heads[index] && _shadows[reg+1] == routes[index].patchParam) break;
+        if (pass == 1 && _shadows[reg] == heads[index]) break;
+        if (pass == 2 && (_shadows[reg] & 0b00001111) != 0) break;
+        if (pass == 3) break;
+      }
+      if (slot > 4) continue;
+      used |= 1<<slot;
+      placed |= 1<<index;
+      image[slot<<1] = heads[index];
+      image[(slot<<1)+1] = routes[index].patchParam;
+    }
+  }
+  for (slot=0; slot<5; ++slot) {
+    if (used & (1<<slot)) continue;
+    reg = (slot<<1)+50;
+    image[slot<<1] = (_shadows[reg] & 0b00001111) ? 0 : _shadows[reg];
+    image[(slot<<1)+1] = _shadows[reg+1];
+  }
+  beginBatch();
+  _update(50, image, 10);
+  commitBatch();
+  return true;
+}
+
+byte BuzzKill::getRouting(buzzkill_route_t routes[]) {
+  byte count = 0;
+  for (byte slot=0; slot<5; ++slot) {
+    byte head = _shadows[(slot<<1)+50];
+    if ((head & 0b00001111) == 0) continue;
+    routes[count].srcMod = (head>>4) & 3;
+    routes[count].destVoice = head>>6;
+    routes[count].patchType = (buzzkill_patch_t)(head & 0b00001111);
+    routes[count].patchParam = _shadows[(slot<<1)+51];
+    ++count;
+  }
+  return count;
+}
+
+void BuzzKill::addSpeechPhonemes(const byte phonemes[], byte length) {
+  BUZZKILL_TRACE_API(ADD_SPEECH);
   if (length == 0) for (; length<255; ++length) if (phonemes[length] == 255) break;
-  if (length < 255) _send(60, phonemes, length);
+  if (length < 255) _command(60, phonemes, length);
 }
 
-void BuzzKill::addSpeechPhonemes(const char phonemes[], byte length=0) {
-  addSpeechPhonemes((byte *)phonemes, length);
+void BuzzKill::addSpeechPhonemes(const char phonemes[], byte length) {
+  BUZZKILL_TRACE_API(ADD_SPEECH);
+  addSpeechPhonemes((const byte *)phonemes, length);
 }
 
-void BuzzKill::addSpeechTags(const char tags[], byte length=0) {
-  char *tagptr = tags;
+void BuzzKill::addSpeechTags(const char tags[], byte length) {
+  BUZZKILL_TRACE_API(ADD_SPEECH);
+  const char *tagptr = tags;
   word count = 0;
   if (length == 0) {
     while (count < 509 && *tagptr && *tagptr != '.') if (*tagptr++ != ' ') ++count;
@@ -222,30 +377,48 @@ void BuzzKill::addSpeechTags(const char tags[], byte length=0) {
     arr[count++] = getPhonemeFromTag(tagptr);
     tagptr+=2;
   }
-  _send(60, arr, length);
+  _command(60, arr, length);
+}
+
+void BuzzKill::addSpeechPhrase(const byte phrase[]) {
+  BUZZKILL_TRACE_API(ADD_SPEECH);
+  byte length = 0;
+  while (length < 255 && pgm_read_byte(phrase + length) != 255) ++length;
+  if (length > 0 && length < 255) _command(60, phrase, length, true);
+}
+
+void BuzzKill::addSpeechPhrase(const byte * const dictionary[], word index) {
+  BUZZKILL_TRACE_API(ADD_SPEECH);
+  addSpeechPhrase((const byte *)pgm_read_ptr(&dictionary[index]));
 }
 
 byte BuzzKill::getPhonemeFromTag(const char tag[]) {
-  byte listIndex;
-  for (listIndex = 0; listIndex < 110; listIndex += 2) if (!strncasecmp_PF(tag, _phonlist + listIndex, 2)) break;
-  return listIndex >> 1;
+  // The hash only narrows the tag down to one candidate, which must then be compared
+  byte phoneme = pgm_read_byte(&_phonhash[_tagHash(tag[0], tag[1])]);
+  if (phoneme == 255 || pgm_read_byte(&_phonlist[phoneme<<1]) != _upper(tag[0]) || pgm_read_byte(&_phonlist[(phoneme<<1)+1]) != _upper(tag[1])) return 55;
+  return phoneme;
 }
 
 void BuzzKill::clearSpeechBuffer() {
-  _send(60, nullptr, 0);
+  BUZZKILL_TRACE_API(CLEAR_SPEECH_BUFFER);
+  _command(60, nullptr, 0);
 }
 
 void BuzzKill::setSpeechSpeed(byte speed) {
+  BUZZKILL_TRACE_API(SET_SPEECH_SPEED);
   if (speed > 253) return;
-  _send(244, &speed, 1);
+  _command(244, &speed, 1);
 }
 
 void BuzzKill::setSpeechFactors(byte form1Freq, byte form1Amp, byte form2Freq, byte form2Amp, byte form3Freq, byte form3Amp, byte form4Freq, byte form4Amp) {
+  BUZZKILL_TRACE_API(SET_SPEECH_FACTORS);
   byte arr[] = { form1Freq, form1Amp, form2Freq, form2Amp, form3Freq, form3Amp, form4Freq, form4Amp };
-  _send(245, arr, 8);
+  _command(245, arr, 8);
 }
 
-void BuzzKill::prepareSpeechMode(double pitch, buzzkill_patch_t patchType) {
+void BuzzKill::prepareSpeechMode(buzzkill_freq_t pitch, buzzkill_patch_t patchType) {
+  BUZZKILL_TRACE_API(PREPARE_SPEECH_MODE);
+  beginBatch();
   configureOscillator(BUZZKILL_OSCTYPE_VOICE, 0, 0.0, BUZZKILL_SHAPE_SINE);
   configureOscillator(BUZZKILL_OSCTYPE_VOICE, 1, 0.0, BUZZKILL_SHAPE_SINE);
   configureOscillator(BUZZKILL_OSCTYPE_VOICE, 2, 0.0, BUZZKILL_SHAPE_SINE);
@@ -258,155 +431,622 @@ void BuzzKill::prepareSpeechMode(double pitch, buzzkill_patch_t patchType) {
   clearPatches();
   addPatch(0, 0, patchType, 255);
   enableVoice(true, true, true, true);
+  commitBatch();
 }
 
 void BuzzKill::startSpeaking() {
-  _send(247, nullptr, 0);
+  BUZZKILL_TRACE_API(START_SPEAKING);
+  _command(247, nullptr, 0);
+  // The speech engine drives the oscillators and envelopes itself, so their contents are no longer known
+  invalidateRegisters();
 }
 
 void BuzzKill::stopSpeaking() {
-  _send(246, nullptr, 0);
+  BUZZKILL_TRACE_API(STOP_SPEAKING);
+  _command(246, nullptr, 0);
 }
 
-void BuzzKill::enableVoice(byte voiceNum, bool enable=true) {
+void BuzzKill::enableVoice(byte voiceNum, bool enable) {
+  BUZZKILL_TRACE_API(ENABLE_VOICE);
   if (voiceNum > 3) return;
-  if (enable) _shadows[24] |= (1<<voiceNum); else _shadows[24] &= ~(1<<voiceNum);
-  _send(48, &_shadows[24], 1);
+  byte val = enable ? (_shadows[48] | (1<<voiceNum)) : (_shadows[48] & ~(1<<voiceNum));
+  _update(48, &val, 1);
 }
 
 void BuzzKill::enableVoice(bool voice0Enable, bool voice1Enable, bool voice2Enable, bool voice3Enable) {
+  BUZZKILL_TRACE_API(ENABLE_VOICE);
   byte mask = (voice3Enable?8:0) | (voice2Enable?4:0) | (voice1Enable?2:0) | (voice0Enable?1:0);
-  _shadows[24] = (_shadows[24] & 0b11110000) | mask;
-  _send(48, &_shadows[24], 1);
+  byte val = (_shadows[48] & 0b11110000) | mask;
+  _update(48, &val, 1);
 }
 
 void BuzzKill::disableVoice(byte voiceNum) {
+  BUZZKILL_TRACE_API(ENABLE_VOICE);
   enableVoice(voiceNum, false);
 }
 
 void BuzzKill::setMasterVolume(byte volume) {
+  BUZZKILL_TRACE_API(SET_MASTER_VOLUME);
   if (volume > 15) return;
-  _shadows[24] = (_shadows[24] & 0b00001111) | (volume<<4);
-  _send(48, &_shadows[24], 1);
+  byte val = (_shadows[48] & 0b00001111) | (volume<<4);
+  _update(48, &val, 1);
 }
 
-void BuzzKill::resetRegisters(byte regStart=0) {
+void BuzzKill::resetRegisters(byte regStart) {
+  BUZZKILL_TRACE_API(RESET_REGISTERS);
   if (regStart > 59) return;
   _resetShadows(regStart);
+  _setBits(_known, regStart, 60-regStart, true);
+  _setBits(_dirty, regStart, 60-regStart, false);
   _send(regStart, nullptr, 0);
 }
 
-void BuzzKill::setRegister(byte regStart, byte val1, int val2=-1, int val3=-1, int val4=-1, int val5=-1, int val6=-1, int val7=-1, int val8=-1, int val9=-1, int val10=-1) {
+void BuzzKill::setRegister(byte regStart, byte val1, int16_t val2, int16_t val3, int16_t val4, int16_t val5, int16_t val6, int16_t val7, int16_t val8, int16_t val9, int16_t val10) {
+  BUZZKILL_TRACE_API(SET_REGISTER);
   int arr16[] = {val1, val2, val3, val4, val5, val6, val7, val8, val9, val10};
-  byte reg=regStart, count, arr8[10];
-  for (count=0; count<10 && arr16[count]>=0; ++count, ++reg) {
-    arr8[count] = arr16[count];
-    if (reg > 48) {
-      if ((reg % 2) == 0) _shadows[reg/2] = arr8[count];
-    }
-    else if (reg > 31) _shadows[reg-24] = arr8[count];
-    else if ((reg % 4) == 3) _shadows[reg/4] = arr8[count];
-  }
-  _send(regStart, arr8, count);
+  byte count, arr8[10];
+  for (count=0; count<10 && arr16[count]>=0; ++count) arr8[count] = arr16[count];
+  if (regStart > 60-count) return;
+  _update(regStart, arr8, count);
 }
 
-void BuzzKill::writeRegisters(byte regStart, byte regData[], byte length) {
+void BuzzKill::writeRegisters(byte regStart, const byte regData[], byte length) {
+  BUZZKILL_TRACE_API(WRITE_REGISTERS);
   if (length < 1 || regStart > 60-length) return;
-  for (byte reg=regStart, count=0; reg<regStart+length; ++reg, ++count) {
-    if (reg > 48) {
-      if ((reg % 2) == 0) _shadows[reg/2] = regData[count];
-    }
-    else if (reg > 31) _shadows[reg-24] = regData[count];
-    else if ((reg % 4) == 3) _shadows[reg/4] = regData[count];
-  }
-  _send(regStart, regData, length);
+  _update(regStart, regData, length);
 }
 
-void BuzzKill::writeRegisters(byte regStart, char regData[], byte length) {
-  writeRegisters(regStart, (byte *)regData, length);
+void BuzzKill::writeRegisters(byte regStart, const char regData[], byte length) {
+  BUZZKILL_TRACE_API(WRITE_REGISTERS);
+  writeRegisters(regStart, (const byte *)regData, length);
 }
 
 void BuzzKill::boardSleep() {
-  _send(251, nullptr, 0);
+  BUZZKILL_TRACE_API(BOARD_SLEEP);
+  _command(251, nullptr, 0);
 }
 
 void BuzzKill::boardWake() {
-  if (_spi) {
-    digitalWrite(_spiSS, LOW);
-    delay(1);
-    digitalWrite(_spiSS, HIGH);
-  }
-  else if (_i2c) {
-    _i2c->beginTransmission(_i2cAddr);
-    _i2c->write(255);
-    _i2c->endTransmission();
-  }
+  BUZZKILL_TRACE_API(BOARD_WAKE);
+  flush();
+  if (_transportOps) _transportOps->wake(_transport);
 }
 
 void BuzzKill::storeCustomWave(const byte wavedata[]) {
-  _send(249, wavedata, 128);
+  BUZZKILL_TRACE_API(STORE_CUSTOM_WAVE);
+  _WaveReader reader(wavedata, _WaveReader::_FROM_RAM);
+  uint32_t sum = _waveChecksum(reader);
+  if (!_waveNeeded(sum)) return;
+  if (_uploadChunk) {
+    _beginUpload(reader, sum);
+    return;
+  }
+  _command(249, wavedata, 128);
   _send(255, wavedata+128, 128);
+  _waveSum = sum;
+  _waveKnown = true;
+}
+
+void BuzzKill::loadCustomWave(const byte wavedata[], bool compressed) {
+  BUZZKILL_TRACE_API(LOAD_CUSTOM_WAVE);
+  _WaveReader reader(wavedata, compressed ? _WaveReader::_FROM_PACKED : _WaveReader::_FROM_FLASH);
+  uint32_t sum = _waveChecksum(reader);
+  if (!_waveNeeded(sum)) return;
+  if (_uploadChunk) {
+    _beginUpload(reader, sum);
+    return;
+  }
+  if (!compressed) {
+    _command(249, wavedata, 128, true);
+    _send(255, wavedata+128, 128, true);
+  }
+  else {
+    // The board takes the 256 values following the command however they are divided, so each piece is sent as decoded
+    byte window[BUZZKILL_WAVE_WINDOW];
+    for (word pos=0; pos<256; pos+=BUZZKILL_WAVE_WINDOW) {
+      for (byte index=0; index<BUZZKILL_WAVE_WINDOW; ++index) window[index] = reader.next();
+      if (pos == 0) _command(249, window, BUZZKILL_WAVE_WINDOW);
+      else _send(255, window, BUZZKILL_WAVE_WINDOW);
+    }
+  }
+  _waveSum = sum;
+  _waveKnown = true;
+}
+
+void BuzzKill::setUploadChunk(byte chunkSize) {
+  flush();
+  _uploadChunk = (chunkSize > BUZZKILL_WAVE_WINDOW) ? BUZZKILL_WAVE_WINDOW : chunkSize;
 }
 
 void BuzzKill::changeI2CAddress(byte newAddr) {
+  BUZZKILL_TRACE_API(CHANGE_I2C_ADDRESS);
   if (newAddr < 8 || newAddr > 119) return;
-  byte arr[] = { newAddr, newAddr ^ 0b01010101, newAddr ^ 0b10101010 };
-  _send(250, arr, 3);
+  byte arr[] = { newAddr, (byte)(newAddr ^ 0b01010101), (byte)(newAddr ^ 0b10101010) };
+  _command(250, arr, 3);
+  flush();
   _i2cAddr = newAddr;
 }
 
+void BuzzKill::beginQueue(byte buffer[], word size) {
+  flush();
+  _queue = buffer;
+  _queueSize = size;
+  _queueHead = _queueTail = _queueCount = 0;
+}
+
+void BuzzKill::endQueue() {
+  flush();
+  _queue = nullptr;
+}
+
+void BuzzKill::poll(word maxMicros) {
+  BUZZKILL_TRACE_API(POLL);
+  unsigned long start = micros();
+  if (_eventCount > 0) _runEvents(start);
+  if (_queueCount == 0 && _uploadPos == 256) return;
+  beginSession();
+  while (_queueCount > 0 || _uploadPos < 256) {
+    _dequeue();
+    if (micros() - start >= maxMicros) break;
+  }
+  endSession();
+}
+
+bool BuzzKill::isIdle() {
+  return _queueCount == 0 && _uploadPos == 256;
+}
+
+void BuzzKill::flush() {
+  BUZZKILL_TRACE_API(FLUSH);
+  if (_queueCount == 0 && _uploadPos == 256) return;
+  beginSession();
+  while (_queueCount > 0 || _uploadPos < 256) _dequeue();
+  endSession();
+}
+
+void BuzzKill::beginSchedule(buzzkill_event_t events[], byte capacity) {
+  _events = events;
+  _eventCapacity = capacity;
+  _eventCount = 0;
+}
+
+void BuzzKill::endSchedule() {
+  _events = nullptr;
+  _eventCapacity = _eventCount = 0;
+}
+
+void BuzzKill::clearSchedule() {
+  _eventCount = 0;
+}
+
+void BuzzKill::cancelEvents(byte reg) {
+  byte count = 0;
+  for (byte index=0; index<_eventCount; ++index) if (_events[index].reg != reg) _events[count++] = _events[index];
+  _eventCount = count;
+}
+
+bool BuzzKill::scheduleRegister(unsigned long delayMicros, byte reg, byte value, byte mask, unsigned long period) {
+  return scheduleRegisterAt(micros() + delayMicros, reg, value, mask, period);
+}
+
+bool BuzzKill::scheduleRegisterAt(unsigned long timeMicros, byte reg, byte value, byte mask, unsigned long period) {
+  if (reg > 59 || _eventCount >= _eventCapacity) return false;
+  buzzkill_event_t event = { timeMicros, period, reg, value, mask };
+  _insertEvent(event);
+  return true;
+}
+
+bool BuzzKill::scheduleNoteOn(unsigned long timeMicros, byte envNum, bool gate, unsigned long period) {
+  if (envNum > 3) return false;
+  return scheduleRegisterAt(timeMicros, (envNum<<2)+34, gate?128:0, 128, period);
+}
+
+bool BuzzKill::scheduleFrequencyRaw(unsigned long timeMicros, buzzkill_osctype_t oscType, byte oscNum, word freq16, unsigned long period) {
+  if (oscNum > 3 || _eventCount+2 > _eventCapacity) return false;
+  byte reg = oscType+(oscNum<<2);
+  scheduleRegisterAt(timeMicros, reg, freq16 & 255, 0xff, period);
+  scheduleRegisterAt(timeMicros, reg+1, freq16 >> 8, 0xff, period);
+  return true;
+}
+
+void BuzzKill::invalidateRegisters() {
+  _setBits(_known, 0, 60, false);
+  _waveKnown = false;
+}
+
+void BuzzKill::saveSnapshot(byte snapshot[]) {
+  memcpy(snapshot, _shadows, BUZZKILL_SNAPSHOT_SIZE);
+}
+
+void BuzzKill::restoreSnapshot(const byte snapshot[], bool keepGates) {
+  BUZZKILL_TRACE_API(RESTORE_SNAPSHOT);
+  byte arr[BUZZKILL_SNAPSHOT_SIZE];
+  memcpy(arr, snapshot, BUZZKILL_SNAPSHOT_SIZE);
+  _restore(arr, keepGates);
+}
+
+void BuzzKill::loadPreset(const buzzkill_preset_t &preset, bool keepGates) {
+  BUZZKILL_TRACE_API(LOAD_PRESET);
+  byte arr[BUZZKILL_SNAPSHOT_SIZE];
+  memcpy_P(arr, preset.regs, BUZZKILL_SNAPSHOT_SIZE);
+  _restore(arr, keepGates);
+}
+
+void BuzzKill::beginBatch() {
+  if (_batchDepth < 255) ++_batchDepth;
+}
+
+void BuzzKill::commitBatch() {
+  BUZZKILL_TRACE_API(COMMIT_BATCH);
+  if (_batchDepth == 0) return;
+  if (--_batchDepth == 0) _flushBatch();
+}
+
+bool BuzzKill::_getBit(const byte mask[], byte reg) {
+  return mask[reg>>3] & (1<<(reg&7));
+}
+
+void BuzzKill::_setBits(byte mask[], byte regStart, byte length, bool value) {
+  for (byte reg=regStart; reg<regStart+length; ++reg) {
+    if (value) mask[reg>>3] |= (1<<(reg&7)); else mask[reg>>3] &= ~(1<<(reg&7));
+  }
+}
+
 void BuzzKill::_resetShadows(byte regStart) {
-  byte index;
-  for (index = 0; index < 8; ++index) if (regStart <= (index<<2) + 3) _shadows[index] = 0;
-  for (index = 0; index < 16; index += 4) if (regStart <= index + 32) _shadows[index + 8] = 0;
-  for (index = 1; index < 16; index += 4) if (regStart <= index + 32) _shadows[index + 8] = 0;
-  for (index = 2; index < 16; index += 4) if (regStart <= index + 32) _shadows[index + 8] = 127;
-  for (index = 3; index < 16; index += 4) if (regStart <= index + 32) _shadows[index + 8] = 240;
-  if (regStart <= 48) _shadows[24] = 240;
-  for (index = 0; index < 5; ++index) if (regStart <= (index<<1) + 50) _shadows[index + 25] = 0;
-}
-
-void BuzzKill::_send(byte command, byte data[], byte length) {
-  byte extra = 255;
+  for (byte reg = regStart; reg < 60; ++reg) _shadows[reg] = _defaultValue(reg);
+}
+
+void BuzzKill::_update(byte regStart, const byte data[], byte length) {
+  byte reg, first = length, last = 0;
+  // In a batch, a second gate change for an envelope would merge with the first into one write, and the envelope
+  // would not restart (e.g. noteOff() then noteOn()); the pending changes are sent first
+  for (byte count=0; _batchDepth && count<length; ++count) {
+    reg = regStart + count;
+    if (reg < 34 || reg >= 48 || (reg & 3) != 2 || !((_shadows[reg] ^ data[count]) & 128)) continue;
+    if (_gatesChanged & (1 << ((reg-34)>>2))) _flushBatch();
+    _gatesChanged |= 1 << ((reg-34)>>2);
+  }
+  for (byte count=0; count<length; ++count) {
+    reg = regStart + count;
+    // Skip registers already known to hold the requested value
+    if (_shadows[reg] == data[count] && _getBit(_known, reg)) continue;
+    _shadows[reg] = data[count];
+    if (_batchDepth) _setBits(_dirty, reg, 1, true);
+    if (first == length) first = count;
+    last = count;
+  }
+  if (first == length || _batchDepth) return;
+  _send(regStart+first, data+first, last-first+1);
+  _setBits(_known, regStart+first, last-first+1, true);
+}
+
+void BuzzKill::_restore(byte image[], bool keepGates) {
+  if (keepGates) {
+    for (byte reg=34; reg<48; reg+=4) image[reg] = (image[reg] & 127) | (_shadows[reg] & 128);
+  }
+  _update(0, image, BUZZKILL_SNAPSHOT_SIZE);
+}
+
+void BuzzKill::_flushBatch() {
+  byte reg = 0, end, next;
+  if (!_queue) beginSession();
+  while (reg < 60) {
+    if (!_getBit(_dirty, reg)) { ++reg; continue; }
+    // Extend the burst over following dirty registers, bridging short gaps whose contents are known
+    end = reg + 1;
+    for (next = end; next < 60 && next <= end + BUZZKILL_BATCH_MAXGAP; ++next) {
+      if (_getBit(_dirty, next)) end = next + 1;
+      else if (!_getBit(_known, next)) break;
+    }
+    _send(reg, &_shadows[reg], end-reg);
+    _setBits(_dirty, reg, end-reg, false);
+    _setBits(_known, reg, end-reg, true);
+    reg = end;
+  }
+  _gatesChanged = 0;
+  if (!_queue) endSession();
+}
+
+void BuzzKill::_command(byte command, const byte data[], byte length, bool flash) {
+  if (_batchDepth) _flushBatch();
+  _send(command, data, length, flash);
+}
+
+void BuzzKill::_insertEvent(const buzzkill_event_t &event) {
+  // Keep events in time order, after any others due at the same time
+  byte index = _eventCount++;
+  while (index > 0 && (long)(_events[index-1].time - event.time) > 0) {
+    _events[index] = _events[index-1];
+    --index;
+  }
+  _events[index] = event;
+}
+
+void BuzzKill::_runEvents(unsigned long now) {
+  buzzkill_event_t event;
+  byte val;
+  beginBatch();
+  while (_eventCount > 0 && (long)(now - _events[0].time) >= 0) {
+    event = _events[0];
+    memmove(&_events[0], &_events[1], --_eventCount * sizeof(buzzkill_event_t));
+    val = (_shadows[event.reg] & ~event.mask) | (event.value & event.mask);
+    _update(event.reg, &val, 1);
+    if (event.period) {
+      // Skip any repeats missed while poll() was not being called
+      do event.time += event.period; while ((long)(now - event.time) >= 0);
+      _insertEvent(event);
+    }
+  }
+  commitBatch();
+}
+
+bool BuzzKill::_queueFits(word size) {
+  if (_queueCount == 0) return size <= _queueSize;
+  if (_queueTail > _queueHead) return _queueSize - _queueTail >= size || _queueHead >= size;
+  return _queueHead - _queueTail >= size;
+}
+
+void BuzzKill::_dequeue() {
+  // Nothing else may reach the board until a wave being sent in pieces is complete
+  if (_uploadPos < 256) {
+    _uploadNext();
+    return;
+  }
+  // Entries are never split across the end of the buffer; a 254 marks unused space before wrapping
+  if (_queueHead >= _queueSize || _queue[_queueHead] == 254) _queueHead = 0;
+  byte command = _queue[_queueHead], length = _queue[_queueHead+1];
+  if (command == 249 && length == 0) {
+    // The wave held for sending in pieces has reached the front of the queue
+    _uploadQueued = false;
+    _uploadPos = 0;
+    _uploadNext();
+  }
+  else _transmit(command, &_queue[_queueHead+2], length);
+  _queueHead += length + 2;
+  if (--_queueCount == 0) _queueHead = _queueTail = 0;
+}
+
+void BuzzKill::_send(byte command, const byte data[], byte length, bool flash) {
+  if (!_queue) {
+    if (_uploadPos < 256) flush();
+    _transmit(command, data, length, flash);
+    return;
+  }
+  word size = length + 2;
+  if (size > _queueSize) {
+    flush();
+    _transmit(command, data, length, flash);
+    return;
+  }
+  BUZZKILL_TRACE_TRANSFER(command, length, BUZZKILL_TRACE_QUEUED);
+  while (!_queueFits(size)) _dequeue();
+  if (_queueCount > 0 && _queueTail > _queueHead && _queueSize - _queueTail < size) {
+    if (_queueTail < _queueSize) _queue[_queueTail] = 254;
+    _queueTail = 0;
+  }
+  _queue[_queueTail] = command;
+  _queue[_queueTail+1] = length;
+  if (length > 0 && flash) memcpy_P(&_queue[_queueTail+2], data, length);
+  else if (length > 0) memcpy(&_queue[_queueTail+2], data, length);
+  _queueTail += size;
+  ++_queueCount;
+}
+
+void BuzzKill::_transmit(byte command, const byte data[], byte length, bool flash) {
+  BUZZKILL_TRACE_TRANSFER(command, length, 0);
+  if (!_transportOps) return;
+  // Registers take the length in the command byte when it is 1..3, and in a second byte otherwise; 255 sends data alone
+  byte header[2], headerLength = 0;
   if (command < 61) {
-    command <<= 2;
-    if (length > 0 && length < 4) command += length; else extra = length;
-  }
-  if (_spi) {
-    _spi->beginTransaction(SPISettings(BUZZKILL_SPI_SPEED, MSBFIRST, SPI_MODE0));
-    digitalWrite(_spiSS, LOW);
-    if (command != 255) _spi->transfer(command);
-    if (extra != 255) _spi->transfer(extra);
-    if (length > 0) _spi->transfer(data, length);
-    digitalWrite(_spiSS, HIGH);
-    _spi->endTransaction();
-  }
-  else if (_i2c) {
-    word count = (extra==255 ? 31 : 30);
-    if (length < count) count = length;
-    _i2c->beginTransmission(_i2cAddr);
-    if (command != 255) _i2c->write(command);
-    if (extra != 255) _i2c->write(extra);
-    while (length > 0) {
-      _i2c->write(data, count);
-      if (length == count) break;
-      _i2c->endTransmission(false);
-      data += count;
-      length -= count;
-      count = (length<32 ? length : 32);
-      _i2c->beginTransmission(_i2cAddr);
+    if (length > 0 && length < 4) header[headerLength++] = (command << 2) + length;
+    else {
+      header[headerLength++] = command << 2;
+      header[headerLength++] = length;
+    }
+  }
+  else if (command != 255) header[headerLength++] = command;
+  _transportOps->transmit(_transport, header, headerLength, data, length, flash);
+}
+
+const BuzzKill::_TransportOps BuzzKill::_spiOps = { _spiTransmit, _spiSession, _spiWake };
+
+const BuzzKill::_TransportOps BuzzKill::_i2cOps = { _i2cTransmit, _i2cSession, _i2cWake };
+
+void BuzzKill::_spiTransmit(void *board, const byte header[], byte headerLength, const byte data[], byte length, bool flash) {
+  BuzzKill *buzzkill = (BuzzKill *)board;
+  SPIClass *spi = buzzkill->_spi;
+  if (!buzzkill->_sessionDepth) spi->beginTransaction(buzzkill->_spiSettings);
+  digitalWrite(buzzkill->_spiSS, LOW);
+  for (byte index=0; index<headerLength; ++index) spi->transfer(header[index]);
+  // Bytes are sent one at a time and the replies discarded, since transfer() on a buffer overwrites it
+  // with the bytes received; the data may be the shadow registers, or const or PROGMEM data from the caller
+  for (byte count=0; count<length; ++count) spi->transfer(flash ? pgm_read_byte(data+count) : data[count]);
+  digitalWrite(buzzkill->_spiSS, HIGH);
+  if (!buzzkill->_sessionDepth) spi->endTransaction();
+}
+
+void BuzzKill::_spiSession(void *board, bool begin) {
+  BuzzKill *buzzkill = (BuzzKill *)board;
+  if (begin) buzzkill->_spi->beginTransaction(buzzkill->_spiSettings);
+  else buzzkill->_spi->endTransaction();
+}
+
+void BuzzKill::_spiWake(void *board) {
+  BuzzKill *buzzkill = (BuzzKill *)board;
+  digitalWrite(buzzkill->_spiSS, LOW);
+  delay(1);
+  digitalWrite(buzzkill->_spiSS, HIGH);
+}
+
+void BuzzKill::_i2cTransmit(void *board, const byte header[], byte headerLength, const byte data[], byte length, bool flash) {
+  BuzzKill *buzzkill = (BuzzKill *)board;
+  TwoWire *i2c = buzzkill->_i2c;
+  // The first piece also carries the header, so it holds less data
+  word count = buzzkill->_i2cBuffer - headerLength;
+  if (length < count) count = length;
+  i2c->beginTransmission(buzzkill->_i2cAddr);
+  for (byte index=0; index<headerLength; ++index) i2c->write(header[index]);
+  while (length > 0) {
+    // Some Wire libraries accept fewer bytes than requested; continue from wherever they stopped
+    if (flash) {
+      for (word sent=0; sent<count; ++sent) if (!i2c->write(pgm_read_byte(data+sent))) { count = sent; break; }
     }
-    _i2c->endTransmission(true);
+    else count = i2c->write(data, count);
+    if (count == 0 || length == count) break;
+    i2c->endTransmission(false);
+    data += count;
+    length -= count;
+    count = (length<buzzkill->_i2cBuffer ? length : buzzkill->_i2cBuffer);
+    i2c->beginTransmission(buzzkill->_i2cAddr);
   }
+  i2c->endTransmission(true);
+}
+
+void BuzzKill::_i2cSession(void *, bool) {
+  // I2C transactions cannot be held open between commands
+}
+
+void BuzzKill::_i2cWake(void *board) {
+  BuzzKill *buzzkill = (BuzzKill *)board;
+  buzzkill->_i2c->beginTransmission(buzzkill->_i2cAddr);
+  buzzkill->_i2c->write(255);
+  buzzkill->_i2c->endTransmission();
 }
 
 void BuzzKill::_timeConvert(word time, byte &range, byte &value) {
-  if (time >= 5000) { range = 3; value = 15; }
-  else if (time >= 1478) { range = 3; value = (time-1478) / 231; }
-  else if (time >= 490) { range = 2; value = (time-490) / 62; }
-  else if (time >= 123) { range = 1; value = (time-123) / 23; }
-  else { range = 0; value = (time+1) / 8; }
+  range = _timeRange(time);
+  value = _timeValue(time);
+}
+
+uint32_t BuzzKill::_waveChecksum(_WaveReader reader) {
+  // Fletcher-style: the second sum depends on the order of the values, not just on the values themselves
+  word sum1 = 0, sum2 = 0;
+  for (word index=0; index<256; ++index) {
+    sum1 += reader.next();
+    sum2 += sum1;
+  }
+  return ((uint32_t)sum2 << 16) | sum1;
+}
+
+#ifdef BUZZKILL_TRACE
+buzzkill_trace_t *BuzzKill::_trace = nullptr;
+byte BuzzKill::_traceCapacity = 0;
+byte BuzzKill::_traceNext = 0;
+byte BuzzKill::_traceCount = 0;
+word BuzzKill::_traceLost = 0;
+byte BuzzKill::_traceApi = BUZZKILL_TRACE_OTHER;
+
+void BuzzKill::beginTrace(buzzkill_trace_t records[], byte capacity) {
+  _trace = nullptr;
+  _traceNext = _traceCount = _traceLost = 0;
+  if (capacity == 0) return;
+  _traceCapacity = capacity;
+  _trace = records;
+}
+
+void BuzzKill::endTrace() {
+  _trace = nullptr;
+  _traceNext = _traceCount = _traceLost = 0;
+}
+
+void BuzzKill::dumpTrace(Print &out) {
+  byte header[] = { 'B', 'K', 'T', 1, _traceCount, (byte)_traceLost, (byte)(_traceLost >> 8) };
+  out.write(header, sizeof(header));
+  // The oldest record is the next to be replaced, once the array has filled
+  byte index = (_traceCount < _traceCapacity) ? 0 : _traceNext;
+  for (byte count=0; count<_traceCount; ++count) {
+    const buzzkill_trace_t &record = _trace[index];
+    byte bytes[13];
+    for (byte shift=0; shift<4; ++shift) {
+      bytes[shift] = record.start >> (shift*8);
+      bytes[shift+4] = record.end >> (shift*8);
+    }
+    bytes[8] = record.api;
+    bytes[9] = record.command;
+    bytes[10] = record.length;
+    bytes[11] = record.device;
+    bytes[12] = record.flags;
+    out.write(bytes, sizeof(bytes));
+    if (++index == _traceCapacity) index = 0;
+  }
+  _traceNext = _traceCount = _traceLost = 0;
+}
+
+void BuzzKill::_traceRecord(unsigned long start, byte command, byte length, byte flags) {
+  if (!_trace) return;
+  buzzkill_trace_t &record = _trace[_traceNext];
+  record.start = start;
+  record.end = micros();
+  record.api = _traceApi;
+  record.command = command;
+  record.length = length;
+  record.device = _i2c ? _i2cAddr : _spi ? _spiSS : 0;
+  record.flags = flags | (_i2c ? BUZZKILL_TRACE_I2C : 0);
+  if (++_traceNext == _traceCapacity) _traceNext = 0;
+  if (_traceCount < _traceCapacity) ++_traceCount;
+  else if (_traceLost < 65535) ++_traceLost;
+}
+#endif
+
+bool BuzzKill::_waveNeeded(uint32_t sum) {
+  // Only one wave can be sent in pieces at a time, so one already under way is finished first
+  if (_uploadQueued || _uploadPos < 256) {
+    if (sum == _uploadSum) return false;
+    flush();
+  }
+  return !_waveKnown || sum != _waveSum;
+}
+
+void BuzzKill::_beginUpload(const _WaveReader &reader, uint32_t sum) {
+  if (_batchDepth) _flushBatch();
+  _upload = reader;
+  _uploadSum = sum;
+  // The board's wave is a mix of old and new until the last piece is sent
+  _waveKnown = false;
+  if (_queue) {
+    // A command 249 with no data holds the wave's place in the queue, behind any commands already waiting
+    _send(249, nullptr, 0);
+    _uploadQueued = true;
+  }
+  else {
+    _uploadPos = 0;
+    _uploadNext();
+  }
+}
+
+void BuzzKill::_uploadNext() {
+  byte piece[BUZZKILL_WAVE_WINDOW], length = _uploadChunk;
+  if (length > 256 - _uploadPos) length = 256 - _uploadPos;
+  for (byte index=0; index<length; ++index) piece[index] = _upload.next();
+  _transmit(_uploadPos == 0 ? 249 : 255, piece, length);
+  _uploadPos += length;
+  if (_uploadPos == 256) {
+    _waveSum = _uploadSum;
+    _waveKnown = true;
+  }
+}
+
+byte BuzzKill::_WaveReader::next() {
+  if (source == _FROM_RAM) return *data++;
+  if (source == _FROM_FLASH) return pgm_read_byte(data++);
+  // Each token covers 1..64 values, given as differences from the value before: 00nnnnnn is followed by 4-bit
+  // differences packed two to a byte, 01nnnnnn by whole-byte differences, and 10nnnnnn repeats the last difference
+  if (count == 0) {
+    token = pgm_read_byte(data++);
+    count = (token & 63) + 1;
+    low = false;
+  }
+  --count;
+  if ((token >> 6) == 0) {
+    if (!low) packed = pgm_read_byte(data++);
+    delta = low ? (packed & 15) : (packed >> 4);
+    if (delta & 8) delta |= 0xf0;
+    low = !low;
+  }
+  else if ((token >> 6) == 1) delta = pgm_read_byte(data++);
+  return value += delta;
 }
 
 constexpr char BuzzKill::_phonlist[];
+constexpr byte BuzzKill::_phonhash[];
 
@@ -16,6 +16,37 @@
 #include <Wire.h>
 
 #define BUZZKILL_SPI_SPEED 400000
+#define BUZZKILL_BATCH_MAXGAP 2
+#define BUZZKILL_SNAPSHOT_SIZE 60
+// Bytes of a compressed custom wave decoded at a time, while it is sent
+#define BUZZKILL_WAVE_WINDOW 32
+
+// Size of the Wire library transmit buffer, which limits how many bytes can be sent in one I2C transaction
+#ifndef BUZZKILL_I2C_BUFFER
+#if defined(I2C_BUFFER_LENGTH)
+#define BUZZKILL_I2C_BUFFER I2C_BUFFER_LENGTH
+#elif defined(WIRE_BUFFER_SIZE)
+#define BUZZKILL_I2C_BUFFER WIRE_BUFFER_SIZE
+#elif defined(BUFFER_LENGTH)
+#define BUZZKILL_I2C_BUFFER BUFFER_LENGTH
+#else
+#define BUZZKILL_I2C_BUFFER 32
+#endif
+#endif
+
+// Un-comment (or define as a build flag) to take frequencies as whole hertz instead of double values,
+// removing all floating point math from the library. Use setFrequencyRaw() or setNoteFrequency() for finer steps.
+//#define BUZZKILL_NO_DOUBLE
+
+#ifdef BUZZKILL_NO_DOUBLE
+typedef word buzzkill_freq_t;
+#else
+typedef double buzzkill_freq_t;
+#endif
+
+// Un-comment (or define as a build flag) to record every bus transfer in a ring buffer, for measuring timing;
+// see beginTrace(). The library must be compiled with the same setting as the sketch, so a build flag is best.
+//#define BUZZKILL_TRACE
 
 enum buzzkill_osctype_t: byte {
     BUZZKILL_OSCTYPE_MOD = 0x00,
@@ -59,6 +90,69 @@ enum buzzkill_patch_t: byte {
     BUZZKILL_PATCH_OUTPUTPIN = 0x0f
 };
 
+struct buzzkill_event_t {
+    unsigned long time;      // micros() value at which the event is due
+    unsigned long period;    // repeat interval in microseconds, or 0 for a one-time event
+    byte reg;                // register number (0..59)
+    byte value;              // new register value
+    byte mask;               // bits of the register to change
+};
+
+#ifdef BUZZKILL_TRACE
+// Public method that caused a traced transfer; when one calls another, the first is recorded
+enum buzzkill_trace_api_t: byte {
+    BUZZKILL_TRACE_OTHER, BUZZKILL_TRACE_SET_FREQUENCY, BUZZKILL_TRACE_SET_NOTE_FREQUENCY, BUZZKILL_TRACE_SET_MIDPOINT,
+    BUZZKILL_TRACE_SET_SHAPE, BUZZKILL_TRACE_SET_INVERT, BUZZKILL_TRACE_SET_REVERSE, BUZZKILL_TRACE_SET_STEP,
+    BUZZKILL_TRACE_CONFIGURE_OSCILLATOR, BUZZKILL_TRACE_RESTART_OSCILLATORS, BUZZKILL_TRACE_HALT_OSCILLATORS,
+    BUZZKILL_TRACE_SET_CURVE, BUZZKILL_TRACE_SET_ATTACK, BUZZKILL_TRACE_SET_DECAY, BUZZKILL_TRACE_SET_SUSTAIN,
+    BUZZKILL_TRACE_SET_RELEASE, BUZZKILL_TRACE_SET_MIX_VOLUME, BUZZKILL_TRACE_NOTE_ON, BUZZKILL_TRACE_NOTE_OFF,
+    BUZZKILL_TRACE_CONFIGURE_ENVELOPE, BUZZKILL_TRACE_ADD_PATCH, BUZZKILL_TRACE_REMOVE_PATCH, BUZZKILL_TRACE_CLEAR_PATCHES,
+    BUZZKILL_TRACE_ADD_SPEECH, BUZZKILL_TRACE_CLEAR_SPEECH_BUFFER, BUZZKILL_TRACE_SET_SPEECH_SPEED,
+    BUZZKILL_TRACE_SET_SPEECH_FACTORS, BUZZKILL_TRACE_PREPARE_SPEECH_MODE, BUZZKILL_TRACE_START_SPEAKING,
+    BUZZKILL_TRACE_STOP_SPEAKING, BUZZKILL_TRACE_ENABLE_VOICE, BUZZKILL_TRACE_SET_MASTER_VOLUME,
+    BUZZKILL_TRACE_RESET_REGISTERS, BUZZKILL_TRACE_SET_REGISTER, BUZZKILL_TRACE_WRITE_REGISTERS, BUZZKILL_TRACE_BOARD_SLEEP,
+    BUZZKILL_TRACE_BOARD_WAKE, BUZZKILL_TRACE_STORE_CUSTOM_WAVE, BUZZKILL_TRACE_LOAD_CUSTOM_WAVE,
+    BUZZKILL_TRACE_CHANGE_I2C_ADDRESS, BUZZKILL_TRACE_POLL, BUZZKILL_TRACE_FLUSH, BUZZKILL_TRACE_RESTORE_SNAPSHOT,
+    BUZZKILL_TRACE_LOAD_PRESET, BUZZKILL_TRACE_COMMIT_BATCH, BUZZKILL_TRACE_SET_ROUTING,
+    BUZZKILL_TRACE_API_COUNT
+};
+
+// Flags of a traced transfer
+#define BUZZKILL_TRACE_QUEUED 0x01     // the command was added to the queue, to be sent later (recorded again then)
+#define BUZZKILL_TRACE_I2C 0x02        // the board is on I2C, and the device is its address; otherwise its SPI select pin
+
+struct buzzkill_trace_t {
+    unsigned long start;     // micros() value when the transfer began
+    unsigned long end;       // micros() value when it was complete
+    byte api;                // the buzzkill_trace_api_t which caused it
+    byte command;            // the first register (0..59), or the command (60..255)
+    byte length;             // number of data bytes
+    byte device;             // SPI select pin or I2C address of the board
+    byte flags;              // BUZZKILL_TRACE_QUEUED, BUZZKILL_TRACE_I2C
+};
+#endif
+
+struct buzzkill_route_t {
+    byte srcMod;                 // modulation oscillator used as the source (0..3)
+    byte destVoice;              // voice oscillator used as the destination (0..3)
+    buzzkill_patch_t patchType;  // patch type, e.g. BUZZKILL_PATCH_FREQSHIFT
+    byte patchParam;             // patch parameter (0..255)
+};
+
+struct buzzkill_preset_t {
+    byte regs[BUZZKILL_SNAPSHOT_SIZE];   // contents of registers 0..59
+};
+
+template <word Length>
+struct buzzkill_phrase_t {
+    byte phonemes[Length+1];             // phoneme values, followed by 0xff
+    constexpr operator const byte *() const { return phonemes; }
+};
+
+struct _buzzkill_preset_root;
+struct _buzzkill_phrase;
+template <class Prev = _buzzkill_preset_root> class BuzzKillPreset;
+
 class BuzzKill {
 public:
     /**
@@ -71,9 +165,33 @@ public:
      * Initialize communication in SPI mode. SPI.begin() should be called before calling this function.
      * @param pinSS          (optional) The pin to use for SS functionality; defaults to global SS definition
      * @param spi            (optional) The SPI object to use; usually no need to specify this
+     * @param speed          (optional) The SPI clock speed in Hz; defaults to BUZZKILL_SPI_SPEED
      */
     void beginSPI(byte pinSS=SS,
-                  SPIClass &spi=SPI);
+                  SPIClass &spi=SPI,
+                  uint32_t speed=BUZZKILL_SPI_SPEED);
+
+
+    /**
+     * Change the SPI clock speed used for communicating with the board.
+     * @param speed          The SPI clock speed in Hz
+     */
+    void setSPISpeed(uint32_t speed);
+
+
+    /**
+     * Begin an SPI session, keeping the SPI transaction open across many commands until endSession() is called.
+     * This avoids the setup cost of a separate transaction for each command, but other devices on the same
+     * SPI bus must not be used while the session is open. Sessions may be nested. Has no effect when using I2C;
+     * with a transport from beginTransport(), the transport decides.
+     */
+    void beginSession();
+
+
+    /**
+     * End an SPI session, releasing the SPI bus for use by other devices.
+     */
+    void endSession();
 
 
     /**
@@ -86,16 +204,86 @@ public:
                   TwoWire &wire=Wire);
 
 
+    /**
+     * Set the number of bytes the Wire library can send in one I2C transaction.
+     * Longer commands are split into pieces of this size, joined by repeated starts.
+     * Normally detected automatically from the Wire library; only needed if detection is wrong for your board.
+     * @param size           The Wire transmit buffer size in bytes (at least 4)
+     */
+    void setI2CBufferSize(word size);
+
+
+    /**
+     * Initialize communication through a transport supplied by the caller, for a bus not covered by beginSPI() or
+     * beginI2C(). The transport is any class with these public methods:
+     *     void transmit(const byte header[], byte headerLength, const byte data[], byte length, bool flash);
+     *     void beginSession();
+     *     void endSession();
+     *     void wake();
+     * transmit() sends the header (0..2 bytes) then the data, as one transfer; if flash is true, the data is in program
+     * memory and must be read with pgm_read_byte(). beginSession() and endSession() mark the outermost session (see
+     * beginSession()), and wake() wakes the board (see boardWake()). The calls are compiled for the transport's class
+     * and reached through one indirect call per transfer, and only the code for buses actually used is included in the
+     * sketch, as with beginSPI() and beginI2C().
+     * @param transport      The transport object; must remain valid while this object is used
+     */
+    template <class Transport>
+    void beginTransport(Transport &transport) {
+        _spi = nullptr;
+        _i2c = nullptr;
+        _transport = &transport;
+        _transportOps = &_TransportFor<Transport>::ops;
+    }
+
+
     /**
      * Set the frequency for a specified oscillator.
      * The desired oscillator is specified by type and number.
      * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
      * @param oscNum         The oscillator number (0..3) within the specified type
      * @param freqency       The oscillator frequency (0.0 - 4095.9375); will be set to next lowest 1/16th
+     *                       (whole hertz 0..4095 if BUZZKILL_NO_DOUBLE is defined)
      */
     void setFrequency(buzzkill_osctype_t oscType,
                       byte oscNum,
-                      double frequency);
+                      buzzkill_freq_t frequency);
+
+
+    /**
+     * Set the frequency for a specified oscillator, using the raw register value.
+     * The desired oscillator is specified by type and number.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param freq16         The oscillator frequency in 1/16ths of a hertz (0..65535), e.g. 7040 for 440 Hz
+     */
+    void setFrequencyRaw(buzzkill_osctype_t oscType,
+                         byte oscNum,
+                         word freq16);
+
+
+    /**
+     * Set the frequency for a specified oscillator to a musical note, using MIDI note numbering.
+     * The desired oscillator is specified by type and number.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param note           The MIDI note number (0..107), e.g. 60 for middle C, 69 for A 440 Hz
+     * @param cents          (optional) Offset from the note in cents (1/100th of a semitone), may be negative
+     */
+    void setNoteFrequency(buzzkill_osctype_t oscType,
+                          byte oscNum,
+                          byte note,
+                          int cents=0);
+
+
+    /**
+     * Convert a MIDI note number to a raw frequency value, as used by setFrequencyRaw().
+     * Cents offsets are interpolated linearly between semitones, accurate to about 1 cent.
+     * @param note           The MIDI note number (0..107)
+     * @param cents          (optional) Offset from the note in cents (1/100th of a semitone), may be negative
+     * @return               The frequency in 1/16ths of a hertz, or 0 if the result is out of range
+     */
+    static word noteToFrequency(byte note,
+                                int cents=0);
 
 
     /**
@@ -164,6 +352,7 @@ public:
      * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
      * @param oscNum         The oscillator number (0..3) within the specified type
      * @param freqency       The oscillator frequency (0.0 - 4095.9375); will be set to next lowest 1/16th
+     *                       (whole hertz 0..4095 if BUZZKILL_NO_DOUBLE is defined)
      * @param shape          The waveform shape (BUZZKILL_SHAPE_SINE, BUZZKILL_SHAPE_RAMP, etc.)
      * @param midpoint       (optional) The oscillator midpoint value, default 128
      * @param invert         (optional) Whether to invert the waveform (true/false), default false
@@ -172,7 +361,7 @@ public:
      */
     void configureOscillator(buzzkill_osctype_t oscType,
                              byte oscNum,
-                             double frequency,
+                             buzzkill_freq_t frequency,
                              buzzkill_shape_t shape,
                              byte midpoint=128,
                              bool invert=false,
@@ -199,7 +388,7 @@ public:
     /**
      * Set the curve type for a specified envelope.
      * @param envNum         The envelope number (0..3)
-     * @param curveType      The curve type (BUZZKILL_CURVE_UP, BUZZKILL_CURVE_DOWN, etc.)
+     * @param curveType      The curve type (BUZZKILL_CURVE_UP, BUZZKILL_CURVE_NATURAL, etc.)
      */
     void setCurve(byte envNum,
                   buzzkill_curve_t curveType);
@@ -323,7 +512,7 @@ public:
      * Configure all options for a specified envelope.
      * All values are manually specified by the user.
      * @param envNum         The envelope number (0..3)
-     * @param curveType      The curve type (BUZZKILL_CURVE_UP, BUZZKILL_CURVE_DOWN, etc.)
+     * @param curveType      The curve type (BUZZKILL_CURVE_UP, BUZZKILL_CURVE_NATURAL, etc.)
      * @param attackRange    The attack range (0-3)
      * @param attackVal      The attack value within the selected range (0..15)
      * @param decayRange     The decay range (0-3)
@@ -351,7 +540,7 @@ public:
      * Configure all options for a specified envelope.
      * Time values are specified in ms and range/value options are calculated automatically.
      * @param envNum         The envelope number (0..3)
-     * @param curveType      The curve type (BUZZKILL_CURVE_UP, BUZZKILL_CURVE_DOWN, etc.)
+     * @param curveType      The curve type (BUZZKILL_CURVE_UP, BUZZKILL_CURVE_NATURAL, etc.)
      * @param attackTime     The desried attack time in ms; the closest possible setting will be selected
      * @param decayTime      The desired decay time in ms; the closest possible setting will be selected
      * @param sustain        The sustain level while the note is on (0..127)
@@ -397,6 +586,28 @@ public:
     void clearPatches();
 
 
+    /**
+     * Set all modulation patches at once, changing as little as possible. A slot which already holds one of the routes
+     * is kept, a slot with the same source, destination and type only has its parameter changed, and the other routes
+     * take the remaining slots; slots not needed are cleared. Only changed registers are sent, in as few bursts as
+     * possible, so switching between routings is cheap enough to do often, e.g. on every beat.
+     * Routes are not kept in the order given, so a routing whose sound depends on slot order should use addPatch().
+     * @param routes         The routes; each is the source, destination, type and parameter of one patch
+     * @param count          The number of routes (0..5); 0 removes all patches
+     * @return               True if successful, false if there are too many routes or one is invalid (nothing is changed)
+     */
+    bool setRouting(const buzzkill_route_t routes[],
+                    byte count);
+
+
+    /**
+     * Read the current modulation patches, as last set through this object, in slot order.
+     * @param routes         An array for the routes; must have space for 5
+     * @return               The number of routes (0..5)
+     */
+    byte getRouting(buzzkill_route_t routes[]);
+
+
     /**
      * Add new phonemes to the end of the speech buffer, pulling from an array of byte values.
      * The array may be terminated by a value of 0xff, or a total length may be specified.
@@ -427,6 +638,24 @@ public:
                        byte length=0);
 
 
+    /**
+     * Add phonemes to the end of the speech buffer, sending them directly from program memory without a copy in RAM.
+     * Intended for phrases defined with BUZZKILL_PHRASE, but any PROGMEM array terminated by a value of 0xff may be used.
+     * @param phrase         An array of phoneme byte values in program memory, terminated by 0xff value
+     */
+    void addSpeechPhrase(const byte phrase[]);
+
+
+    /**
+     * Add phonemes to the end of the speech buffer, from a phrase listed in a dictionary in program memory.
+     * The dictionary is a PROGMEM array of phrases, e.g. const byte * const dictionary[] PROGMEM = { hello, goodbye };
+     * @param dictionary     A PROGMEM array of pointers to phrases in program memory
+     * @param index          The position of the phrase within the dictionary
+     */
+    void addSpeechPhrase(const byte * const dictionary[],
+                         word index);
+
+
     /**
      * Convert a two-letter text tag into a numeric phoneme value
     */
@@ -477,7 +706,7 @@ public:
      * @param pitch          Speech pitch value (in hertz)
      * @param patchType      Patch type for pitch modulation; e.g. BUZZKILL_PATCH_AMPSCALEMULTI or BUZZKILL_PATCH_HARDSYNCMULTI   
      */
-    void prepareSpeechMode(double pitch,
+    void prepareSpeechMode(buzzkill_freq_t pitch,
                            buzzkill_patch_t patchType);
 
 
@@ -560,7 +789,7 @@ public:
      * @param length         Total number of values to pull and write
      */
     void writeRegisters(byte regStart,
-                        byte regData[],
+                        const byte regData[],
                         byte length);
 
 
@@ -572,7 +801,7 @@ public:
      * @param length         Number of values to pull and write
      */
     void writeRegisters(byte regStart,
-                        char regData[],
+                        const char regData[],
                         byte length);
 
 
@@ -589,11 +818,38 @@ public:
 
     /**
      * Define a custom waveform shape, consisting of 256 values each in the range (0..255).
+     * The upload is skipped if the board already holds the same wave, as last stored by this object.
+     * If setUploadChunk() has been used, the wave is sent in pieces by poll(), and the array must not change until it is sent.
      * @param wavedata       An array of bytes which define the waveform; must contain at least 256 values
      */
     void storeCustomWave(const byte wavedata[]);
 
 
+    /**
+     * Define a custom waveform shape from a wave stored in program memory, either as 256 plain values (0..255) or in
+     * the compressed form made by BuzzKillWave::compress(). A compressed wave is decoded a few bytes at a time as it is
+     * sent, so no RAM is needed to hold it. The upload is skipped if the board already holds the same wave.
+     * @param wavedata       The wave, which must be declared PROGMEM
+     * @param compressed     (optional) Whether the wave is compressed (true/false); defaults to true
+     */
+    void loadCustomWave(const byte wavedata[],
+                        bool compressed=true);
+
+
+    /**
+     * Send later custom waves in the background, a piece at a time, instead of all at once.
+     * The first piece is sent straight away (or when the wave reaches the front of the queue), and each call to poll()
+     * sends more, so the caller does not wait several milliseconds for the whole wave, and other devices can use the
+     * bus between pieces. The board takes the 256 values following the upload command as the wave, so nothing else
+     * can be sent to it until the last piece: with queueing enabled, later commands wait in the queue behind the wave;
+     * without it, any other command first sends the rest of the wave, so it is delayed no more than before.
+     * The board is only recorded as holding the new wave once the last piece has been sent.
+     * @param chunkSize      The number of values in each piece (1..BUZZKILL_WAVE_WINDOW), or 0 to send waves all at once;
+     *                       defaults to 0
+     */
+    void setUploadChunk(byte chunkSize);
+
+
     /**
      * Change the board I2C address. This is a hardware-level change, and affects all future I2C communication.
      * The new address will be automatically used by the current session, no need to call .beginI2C() again.
@@ -602,16 +858,622 @@ public:
      */
     void changeI2CAddress(byte newAddr);
 
+
+    /**
+     * Forget the locally recorded register contents.
+     * Register writes which would not change the board's current value are normally skipped; after this call,
+     * each register is always written the next time it is set, and the next custom wave is always uploaded.
+     * Use this if the board may have been changed by other means, e.g. power cycled or written by another controller.
+     * Calling resetRegisters() also re-syncs the registers.
+     */
+    void invalidateRegisters();
+
+
+    /**
+     * Save the current contents of all sound registers (0..59), as last written by this object, into a byte array.
+     * The board is not accessed; the snapshot can later be passed to restoreSnapshot().
+     * @param snapshot       A byte array to hold the register contents; must contain at least BUZZKILL_SNAPSHOT_SIZE values
+     */
+    void saveSnapshot(byte snapshot[]);
+
+
+    /**
+     * Restore all sound registers (0..59) from a snapshot made by saveSnapshot().
+     * Changed registers are written in a single burst, from the first changed register to the last.
+     * @param snapshot       A byte array filled by saveSnapshot()
+     * @param keepGates      (optional) Whether to leave the envelope gates as they are now (true/false); defaults to false
+     */
+    void restoreSnapshot(const byte snapshot[],
+                         bool keepGates=false);
+
+
+    /**
+     * Load all sound registers (0..59) from a preset stored in program memory, usually one built with BuzzKillPreset.
+     * Changed registers are written in a single burst, from the first changed register to the last.
+     * @param preset         The preset, which must be declared PROGMEM
+     * @param keepGates      (optional) Whether to leave the envelope gates as they are now (true/false); defaults to false
+     */
+    void loadPreset(const buzzkill_preset_t &preset,
+                    bool keepGates=false);
+
+
+    /**
+     * Begin a batch of register updates. Until the matching commitBatch(), register changes made by any method
+     * are only recorded locally, and are then sent together using as few bus transactions as possible.
+     * Other commands (speech, restartOscillators, etc.) send any pending updates first, so ordering is preserved.
+     * Batches may be nested; only the outermost commitBatch() sends data.
+     */
+    void beginBatch();
+
+
+    /**
+     * End a batch of register updates, sending all pending changes as contiguous bursts.
+     * Gaps of up to BUZZKILL_BATCH_MAXGAP unchanged registers are filled in to join neighboring bursts.
+     */
+    void commitBatch();
+
+
+    /**
+     * Enable queued transmission, using a buffer supplied by the caller.
+     * Commands are stored in the buffer and sent later by poll() or flush(), so the caller does not wait for the bus.
+     * If the buffer is too full for a new command, queued commands are sent immediately until there is room.
+     * Commands larger than the whole buffer are sent directly, after the queue has been flushed.
+     * @param buffer         A byte array to hold queued commands; must remain valid until endQueue() is called
+     * @param size           The size of the buffer in bytes; 160 or more allows a custom waveform to be queued
+     */
+    void beginQueue(byte buffer[],
+                    word size);
+
+
+    /**
+     * Send any queued commands and return to direct (blocking) transmission.
+     */
+    void endQueue();
+
+
+    /**
+     * Carry out scheduled events that are due, then send queued commands until the queue is empty or the time limit
+     * is reached. This should be called frequently, e.g. from loop(); event timing is only as accurate as the calls.
+     * At least one command is sent if any are waiting, and a single command is never split,
+     * so one call may take longer than the limit for large commands. Custom waves being sent in pieces
+     * (see setUploadChunk()) are continued here, before any other queued commands.
+     * @param maxMicros      (optional) The time limit in microseconds; defaults to 500
+     */
+    void poll(word maxMicros=500);
+
+
+    /**
+     * Check whether all queued commands, and any custom wave being sent in pieces, have been sent.
+     * @return               True if there is nothing left to send
+     */
+    bool isIdle();
+
+
+    /**
+     * Send all queued commands, and the rest of any custom wave being sent in pieces, waiting until they are complete.
+     */
+    void flush();
+
+
+    /**
+     * Enable the event scheduler, using an array supplied by the caller to hold pending events.
+     * Scheduled events change register values at a set time, and are carried out by poll().
+     * @param events         An array to hold pending events; must remain valid until endSchedule() is called
+     * @param capacity       The number of events the array can hold
+     */
+    void beginSchedule(buzzkill_event_t events[],
+                       byte capacity);
+
+
+    /**
+     * Disable the event scheduler, discarding any pending events.
+     */
+    void endSchedule();
+
+
+    /**
+     * Discard all pending events.
+     */
+    void clearSchedule();
+
+
+    /**
+     * Discard all pending events for a specific register.
+     * @param reg            The register number (0..59)
+     */
+    void cancelEvents(byte reg);
+
+
+    /**
+     * Schedule a register change at a time relative to now.
+     * Events due at the same time are carried out in the order they were scheduled, and sent together.
+     * @param delayMicros    Time from now until the event, in microseconds
+     * @param reg            The register number (0..59)
+     * @param value          The new register value
+     * @param mask           (optional) Which bits of the register to change; defaults to all bits
+     * @param period         (optional) Repeat interval in microseconds; defaults to 0 (no repeat)
+     * @return               True if successful, false if the schedule is full or not enabled
+     */
+    bool scheduleRegister(unsigned long delayMicros,
+                          byte reg,
+                          byte value,
+                          byte mask=0xff,
+                          unsigned long period=0);
+
+
+    /**
+     * Schedule a register change at an absolute time.
+     * Using a common starting time for several events keeps them exactly in step, e.g. for repeating patterns.
+     * @param timeMicros     The micros() value at which the event is due
+     * @param reg            The register number (0..59)
+     * @param value          The new register value
+     * @param mask           (optional) Which bits of the register to change; defaults to all bits
+     * @param period         (optional) Repeat interval in microseconds; defaults to 0 (no repeat)
+     * @return               True if successful, false if the schedule is full or not enabled
+     */
+    bool scheduleRegisterAt(unsigned long timeMicros,
+                            byte reg,
+                            byte value,
+                            byte mask=0xff,
+                            unsigned long period=0);
+
+
+    /**
+     * Schedule the gate bit for an envelope to be set or cleared at an absolute time.
+     * @param timeMicros     The micros() value at which the event is due
+     * @param envNum         The envelope number (0..3)
+     * @param gate           (optional) Whether to gate the note on or off (true/false); defaults to true
+     * @param period         (optional) Repeat interval in microseconds; defaults to 0 (no repeat)
+     * @return               True if successful, false if the schedule is full or not enabled
+     */
+    bool scheduleNoteOn(unsigned long timeMicros,
+                        byte envNum,
+                        bool gate=true,
+                        unsigned long period=0);
+
+
+    /**
+     * Schedule a frequency change for an oscillator at an absolute time, using the raw register value.
+     * @param timeMicros     The micros() value at which the event is due
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param freq16         The oscillator frequency in 1/16ths of a hertz (0..65535)
+     * @param period         (optional) Repeat interval in microseconds; defaults to 0 (no repeat)
+     * @return               True if successful, false if the schedule does not have room for two events
+     */
+    bool scheduleFrequencyRaw(unsigned long timeMicros,
+                              buzzkill_osctype_t oscType,
+                              byte oscNum,
+                              word freq16,
+                              unsigned long period=0);
+
+#ifdef BUZZKILL_TRACE
+
+    /**
+     * Start recording bus transfers, for all boards, in an array supplied by the caller. Only available if BUZZKILL_TRACE
+     * is defined. Each transfer is recorded with its command, length, board, start and end times and the public method
+     * which caused it. A queued command is recorded when it is queued, and again when it is sent. Once the array is full,
+     * each new record replaces the oldest.
+     * @param records        An array to hold the records; must remain valid until endTrace() is called
+     * @param capacity       The number of records the array can hold (1..255)
+     */
+    static void beginTrace(buzzkill_trace_t records[],
+                           byte capacity);
+
+
+    /**
+     * Stop recording bus transfers, discarding any records.
+     */
+    static void endTrace();
+
+
+    /**
+     * Write the records held, oldest first, in a compact binary form, and then discard them. The output starts with
+     * the bytes "BKT", a format version (1), the number of records, and the number of records lost since the last dump
+     * (2 bytes); each record then takes 13 bytes, with times least significant byte first. The program
+     * extras/host/trace_decode.cpp turns this into a readable table.
+     * @param out            Where to write the records, e.g. Serial
+     */
+    static void dumpTrace(Print &out);
+#endif
+
 private:
+    // Bus code is reached only through the table set by beginSPI(), beginI2C() or beginTransport(), so a sketch
+    // only links the code for the buses it uses. The price is one indirect call per transfer (and per session or
+    // wake), which the compiler cannot inline, plus the table pointer in each object; small next to the transfer itself
+    struct _TransportOps {
+        void (*transmit)(void *transport, const byte header[], byte headerLength, const byte data[], byte length, bool flash);
+        void (*session)(void *transport, bool begin);
+        void (*wake)(void *transport);
+    };
+    template <class Transport> struct _TransportFor {
+        static void transmit(void *transport, const byte header[], byte headerLength, const byte data[], byte length, bool flash) {
+            static_cast<Transport *>(transport)->transmit(header, headerLength, data, length, flash);
+        }
+        static void session(void *transport, bool begin) {
+            if (begin) static_cast<Transport *>(transport)->beginSession();
+            else static_cast<Transport *>(transport)->endSession();
+        }
+        static void wake(void *transport) {
+            static_cast<Transport *>(transport)->wake();
+        }
+        static const _TransportOps ops;
+    };
+    static const _TransportOps _spiOps;
+    static const _TransportOps _i2cOps;
+    const _TransportOps *_transportOps=nullptr;
+    void *_transport=nullptr;
     SPIClass *_spi=nullptr;
     TwoWire *_i2c=nullptr;
     byte _spiSS;
+    SPISettings _spiSettings;
+    byte _sessionDepth=0;
     byte _i2cAddr;
-    byte _shadows[30];
+    word _i2cBuffer=BUZZKILL_I2C_BUFFER;
+    byte _shadows[60];
+    byte _known[8]={0};
+    byte _dirty[8]={0};
+    byte _gatesChanged=0;
+    byte _batchDepth=0;
+    byte *_queue=nullptr;
+    word _queueSize=0;
+    word _queueHead=0;
+    word _queueTail=0;
+    word _queueCount=0;
+    buzzkill_event_t *_events=nullptr;
+    byte _eventCapacity=0;
+    byte _eventCount=0;
+    uint32_t _waveSum=0;
+    bool _waveKnown=false;
+    // Reads the 256 values of a custom wave in order: from RAM, from program memory, or compressed in program memory
+    struct _WaveReader {
+        enum _Source: byte { _FROM_RAM, _FROM_FLASH, _FROM_PACKED };
+        const byte *data;
+        _Source source;
+        byte value=0;                    // last value read
+        byte delta=0;                    // difference between the last two values
+        byte token=0;                    // compressed form: current token, and number of values it has left
+        byte count=0;
+        byte packed=0;                   // compressed form: byte holding two 4-bit differences, and whether the second is next
+        bool low=false;
+        _WaveReader(const byte *wavedata, _Source from) : data(wavedata), source(from) {}
+        byte next();
+    };
+    _WaveReader _upload{nullptr, _WaveReader::_FROM_RAM};
+    uint32_t _uploadSum=0;
+    word _uploadPos=256;                 // next value of a wave being sent in pieces, or 256 if none is being sent
+    byte _uploadChunk=0;
+    bool _uploadQueued=false;            // a wave waits in the queue, behind a 249 entry with no data
+    static const word _noteTable[12] PROGMEM;
     static constexpr char _phonlist[] PROGMEM = "OWAWEYAIAYEAOYURAEAAAUEHIYAOERAHUWUHIHAXS*SHF*V*Z*ZHTHDHM*N*NGH*X*R*RXL*LXW*WHY*WXYXKXGXT*D*P*B*K*G*J*CH_1_2_3";
+    // Phoneme for each value of _tagHash(), or 255 if none; every tag in _phonlist has a different hash value
+    static constexpr byte _phonhash[128] PROGMEM = {
+        47, 255, 255, 43, 23, 255, 35, 255, 54, 11, 255, 255, 3, 255, 16, 255, 8, 255, 1, 7, 255, 48, 255, 255, 50, 255, 25, 255, 4, 41, 44, 255,
+        10, 255, 32, 255, 255, 255, 255, 255, 255, 255, 255, 255, 29, 255, 45, 255, 255, 37, 34, 28, 9, 255, 255, 255, 255, 30, 52, 255, 255, 18, 255, 21,
+        255, 49, 255, 14, 36, 15, 255, 255, 24, 255, 46, 255, 26, 255, 255, 255, 2, 255, 6, 255, 22, 19, 255, 42, 255, 17, 13, 255, 0, 255, 255, 39,
+        255, 255, 255, 38, 12, 255, 255, 255, 255, 255, 255, 255, 255, 20, 255, 51, 33, 53, 31, 40, 255, 255, 255, 255, 5, 255, 255, 255, 27, 255, 255, 255
+    };
+    static constexpr char _upper(char c) {
+        return (c >= 'a' && c <= 'z') ? c - 32 : c;
+    }
+    static constexpr byte _tagHash(char first, char second) {
+        return ((_upper(first) * 13) ^ (_upper(second) * 57)) & 127;
+    }
+#ifdef BUZZKILL_TRACE
+    static buzzkill_trace_t *_trace;
+    static byte _traceCapacity;
+    static byte _traceNext;
+    static byte _traceCount;
+    static word _traceLost;
+    static byte _traceApi;
+    // Records the outermost public method running, for as long as it runs
+    struct _TraceScope {
+        byte outer;
+        _TraceScope(buzzkill_trace_api_t api) : outer(_traceApi) { if (outer == BUZZKILL_TRACE_OTHER) _traceApi = api; }
+        ~_TraceScope() { _traceApi = outer; }
+    };
+    // Records a transfer when it goes out of scope
+    struct _TraceTransfer {
+        BuzzKill *buzzkill;
+        unsigned long start;
+        byte command, length, flags;
+        _TraceTransfer(BuzzKill *board, byte cmd, byte len, byte traceFlags) : buzzkill(board), start(micros()), command(cmd), length(len), flags(traceFlags) {}
+        ~_TraceTransfer() { buzzkill->_traceRecord(start, command, length, flags); }
+    };
+    void _traceRecord(unsigned long start, byte command, byte length, byte flags);
+#endif
+    template <class Prev> friend class BuzzKillPreset;
+    friend struct _buzzkill_preset_root;
+    friend struct _buzzkill_phrase;
+    friend class BuzzKillGroup;
+    friend class BuzzKillAutomation;
+    static constexpr byte _defaultValue(byte reg) {
+        return (reg < 32 || reg > 48) ? 0 : (reg == 48) ? 240 : ((reg & 3) == 2) ? 127 : ((reg & 3) == 3) ? 240 : 0;
+    }
+    static constexpr byte _timeRange(word time) {
+        return (time >= 1478) ? 3 : (time >= 490) ? 2 : (time >= 123) ? 1 : 0;
+    }
+    static constexpr byte _timeValue(word time) {
+        return (time >= 5000) ? 15 : (time >= 1478) ? (time-1478) / 231 : (time >= 490) ? (time-490) / 62 : (time >= 123) ? (time-123) / 23 : (time+1) / 8;
+    }
+    static bool _getBit(const byte mask[], byte reg);
+    static void _setBits(byte mask[], byte regStart, byte length, bool value);
+    void _joinSession(bool begin);
     void _resetShadows(byte regStart);
     void _timeConvert(word time, byte &range, byte &value);
-    void _send(byte command, byte data[], byte length);
+    static uint32_t _waveChecksum(_WaveReader reader);
+    bool _waveNeeded(uint32_t sum);
+    void _beginUpload(const _WaveReader &reader, uint32_t sum);
+    void _uploadNext();
+    void _update(byte regStart, const byte data[], byte length);
+    void _restore(byte image[], bool keepGates);
+    void _flushBatch();
+    void _command(byte command, const byte data[], byte length, bool flash=false);
+    bool _queueFits(word size);
+    void _dequeue();
+    void _insertEvent(const buzzkill_event_t &event);
+    void _runEvents(unsigned long now);
+    void _send(byte command, const byte data[], byte length, bool flash=false);
+    void _transmit(byte command, const byte data[], byte length, bool flash=false);
+    static void _spiTransmit(void *board, const byte header[], byte headerLength, const byte data[], byte length, bool flash);
+    static void _spiSession(void *board, bool begin);
+    static void _spiWake(void *board);
+    static void _i2cTransmit(void *board, const byte header[], byte headerLength, const byte data[], byte length, bool flash);
+    static void _i2cSession(void *board, bool begin);
+    static void _i2cWake(void *board);
+};
+
+template <class Transport>
+const BuzzKill::_TransportOps BuzzKill::_TransportFor<Transport>::ops = { transmit, session, wake };
+
+// Called when a BuzzKillPreset parameter is out of range. This is not constexpr, so a preset declared constexpr
+// fails to compile, with this name in the error message. A preset built at run time gets 0 for the affected registers.
+inline uint32_t buzzkill_preset_parameter_out_of_range() { return 0; }
+
+// Marks the public method running, for tracing; compiled out unless BUZZKILL_TRACE is defined
+#ifdef BUZZKILL_TRACE
+#define BUZZKILL_TRACE_API(api) BuzzKill::_TraceScope _traceScope(BUZZKILL_TRACE_##api)
+#define BUZZKILL_TRACE_TRANSFER(command, length, flags) BuzzKill::_TraceTransfer _traceTransfer(this, command, length, flags)
+#else
+#define BUZZKILL_TRACE_API(api)
+#define BUZZKILL_TRACE_TRANSFER(command, length, flags)
+#endif
+
+struct _buzzkill_preset_root {
+    constexpr byte reg(byte regNum) const { return BuzzKill::_defaultValue(regNum); }
+};
+
+// Called when a BUZZKILL_PHRASE tag is not in the phoneme list, or a tag is missing its second letter.
+// This is not constexpr, so the phrase fails to compile, with this name in the error message.
+inline byte buzzkill_phrase_unknown_tag() { return 55; }
+
+// Called when a BUZZKILL_PHRASE holds more than 254 phonemes. This is not constexpr, so the phrase fails to compile.
+inline byte buzzkill_phrase_too_long() { return 0; }
+
+template <byte... Index> struct _buzzkill_indices {};
+template <byte Count, byte... Index> struct _buzzkill_make_indices : _buzzkill_make_indices<Count-1, Count-1, Index...> {};
+template <byte... Index> struct _buzzkill_make_indices<0, Index...> { typedef _buzzkill_indices<Index...> type; };
+
+struct _buzzkill_phrase {
+    // Position of the first character at or after pos which is not a space
+    static constexpr word skip(const char *tags, word pos) {
+        return (tags[pos] == ' ') ? skip(tags, pos+1) : pos;
+    }
+    // Number of tags starting at pos, which must not be a space
+    static constexpr word countFrom(const char *tags, word pos) {
+        return (tags[pos] == 0 || tags[pos] == '.') ? 0 : (tags[pos+1] == 0) ? buzzkill_phrase_unknown_tag() : 1 + countFrom(tags, skip(tags, pos+2));
+    }
+    static constexpr word count(const char *tags) {
+        return (countFrom(tags, skip(tags, 0)) > 254) ? buzzkill_phrase_too_long() : countFrom(tags, skip(tags, 0));
+    }
+    // Position of tag number index
+    static constexpr word tagPos(const char *tags, word index) {
+        return skip(tags, (index == 0) ? 0 : tagPos(tags, index-1) + 2);
+    }
+    static constexpr byte match(byte phoneme, const char *tag) {
+        return (phoneme < 55 && BuzzKill::_phonlist[phoneme<<1] == BuzzKill::_upper(tag[0]) && BuzzKill::_phonlist[(phoneme<<1)+1] == BuzzKill::_upper(tag[1])) ?
+               phoneme : buzzkill_phrase_unknown_tag();
+    }
+    static constexpr byte phoneme(const char *tag) {
+        return match(BuzzKill::_phonhash[BuzzKill::_tagHash(tag[0], tag[1])], tag);
+    }
+    template <byte... Index> static constexpr buzzkill_phrase_t<sizeof...(Index)> encode(const char *tags, _buzzkill_indices<Index...>) {
+        return buzzkill_phrase_t<sizeof...(Index)>{{ phoneme(tags + tagPos(tags, Index))..., 255 }};
+    }
+};
+
+/**
+ * Define a phrase for addSpeechPhrase(), converting two-letter text tags to phoneme values at compile time.
+ * The phrase is stored in program memory, and an unknown tag is a compile error. For example:
+ *
+ *     BUZZKILL_PHRASE(hello, "H* EH L* OW");
+ *
+ * @param name           The name of the phrase variable to define
+ * @param tags           A string literal containing a sequence of two-letter text tags, as for addSpeechTags()
+ */
+#define BUZZKILL_PHRASE(name, tags) \
+    constexpr buzzkill_phrase_t<_buzzkill_phrase::count(tags)> name PROGMEM = \
+        _buzzkill_phrase::encode(tags, _buzzkill_make_indices<_buzzkill_phrase::count(tags)>::type())
+
+/**
+ * Builds a complete register image at compile time, to be stored in program memory and sent with loadPreset().
+ * Start from BuzzKillPreset<>(), which holds the same values as resetRegisters(), and chain calls that mirror the
+ * BuzzKill methods of the same name, ending with image(). For example:
+ *
+ *     constexpr buzzkill_preset_t bell PROGMEM = BuzzKillPreset<>()
+ *         .configureOscillator(BUZZKILL_OSCTYPE_VOICE, 0, 880, BUZZKILL_SHAPE_SINE)
+ *         .configureEnvelope(0, BUZZKILL_CURVE_NATURAL, 5, 800, 0, 800, 15, false)
+ *         .enableVoice(0)
+ *         .image();
+ *
+ * All math, including frequency scaling and envelope time conversion, is done by the compiler. When the preset is
+ * declared constexpr, an out-of-range parameter is a compile error rather than being silently ignored.
+ */
+template <class Prev>
+class BuzzKillPreset {
+public:
+    /**
+     * Constructor, no parameters. The preset starts with the same values as resetRegisters().
+     */
+    constexpr BuzzKillPreset() : _prev(), _start(0), _value(0), _mask(0) {}
+
+
+    /**
+     * Constructor used internally to add one change to a preset.
+     * @param prev           The preset before the change
+     * @param start          The first register changed (0..59)
+     * @param value          New values for up to 4 consecutive registers, starting register in the low byte
+     * @param mask           The bits of those registers to change
+     */
+    constexpr BuzzKillPreset(const Prev &prev, byte start, uint32_t value, uint32_t mask) : _prev(prev), _start(start), _value(value), _mask(mask) {}
+
+
+    /**
+     * Configure all options for a specified oscillator; see BuzzKill::configureOscillator().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> configureOscillator(buzzkill_osctype_t oscType,
+                                                                 byte oscNum,
+                                                                 double frequency,
+                                                                 buzzkill_shape_t shape,
+                                                                 byte midpoint=128,
+                                                                 bool invert=false,
+                                                                 bool reverse=false,
+                                                                 byte step=0) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, oscType+(oscNum<<2),
+            _check(oscNum <= 3 && step <= 7 && frequency >= 0 && frequency < 4096,
+                   (word)(frequency*16) | (uint32_t)midpoint<<16 | (uint32_t)(shape | (reverse?16:0) | (invert?8:0) | step)<<24),
+            0xffffffff);
+    }
+
+
+    /**
+     * Configure all options for a specified envelope; see BuzzKill::configureEnvelope().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> configureEnvelope(byte envNum,
+                                                               buzzkill_curve_t curveType,
+                                                               byte attackRange,
+                                                               byte attackVal,
+                                                               byte decayRange,
+                                                               byte decayVal,
+                                                               byte sustain,
+                                                               byte releaseRange,
+                                                               byte releaseVal,
+                                                               byte mixVol,
+                                                               bool noteOn) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, (envNum<<2)+32,
+            _check(envNum <= 3 && attackRange <= 3 && attackVal <= 15 && decayRange <= 3 && decayVal <= 15 && sustain <= 127 &&
+                   releaseRange <= 3 && releaseVal <= 15 && mixVol <= 15,
+                   (curveType | releaseRange<<4 | decayRange<<2 | attackRange) | (uint32_t)(decayVal<<4 | attackVal)<<8 |
+                   (uint32_t)((noteOn?128:0) | sustain)<<16 | (uint32_t)(mixVol<<4 | releaseVal)<<24),
+            0xffffffff);
+    }
+
+
+    /**
+     * Configure all options for a specified envelope, with times in ms; see BuzzKill::configureEnvelope().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> configureEnvelope(byte envNum,
+                                                               buzzkill_curve_t curveType,
+                                                               word attackTime,
+                                                               word decayTime,
+                                                               byte sustain,
+                                                               word releaseTime,
+                                                               byte mixVol,
+                                                               bool noteOn) const {
+        return configureEnvelope(envNum, curveType, BuzzKill::_timeRange(attackTime), BuzzKill::_timeValue(attackTime),
+                                 BuzzKill::_timeRange(decayTime), BuzzKill::_timeValue(decayTime), sustain,
+                                 BuzzKill::_timeRange(releaseTime), BuzzKill::_timeValue(releaseTime), mixVol, noteOn);
+    }
+
+
+    /**
+     * Add a modulation patch in the lowest unused slot; see BuzzKill::addPatch().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> addPatch(byte srcMod,
+                                                      byte destVoice,
+                                                      buzzkill_patch_t patchType,
+                                                      byte patchParam) const {
+        return _addPatch(_freeSlot(0), srcMod, destVoice, patchType, patchParam);
+    }
+
+
+    /**
+     * Enable/Disable the audio output for a specific voice oscillator; see BuzzKill::enableVoice().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> enableVoice(byte voiceNum,
+                                                         bool enable=true) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, 48, _check(voiceNum <= 3, enable ? 1<<voiceNum : 0), 1<<(voiceNum&3));
+    }
+
+
+    /**
+     * Set the master (global) volume level; see BuzzKill::setMasterVolume().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> setMasterVolume(byte volume) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, 48, _check(volume <= 15, volume<<4), 0xf0);
+    }
+
+
+    /**
+     * Set the oscillator halt mask; see BuzzKill::haltOscillators().
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> haltOscillators(byte haltMask) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, 49, haltMask, 0xff);
+    }
+
+
+    /**
+     * Set the value of a single register.
+     * @param reg            The register number (0..59)
+     * @param value          The value to be written
+     */
+    constexpr BuzzKillPreset<BuzzKillPreset> setRegister(byte reg,
+                                                         byte value) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, reg, _check(reg <= 59, value), 0xff);
+    }
+
+
+    /**
+     * Get the value the preset holds for one register.
+     * @param regNum         The register number (0..59)
+     * @return               The register value
+     */
+    constexpr byte reg(byte regNum) const {
+        return _merge(_prev.reg(regNum), regNum - _start);
+    }
+
+
+    /**
+     * Get the complete register image, for storing in program memory.
+     * @return               The register image
+     */
+    constexpr buzzkill_preset_t image() const {
+        return _image(typename _buzzkill_make_indices<BUZZKILL_SNAPSHOT_SIZE>::type());
+    }
+
+private:
+    Prev _prev;
+    byte _start;
+    uint32_t _value;
+    uint32_t _mask;
+    static constexpr uint32_t _check(bool valid, uint32_t value) {
+        return valid ? value : buzzkill_preset_parameter_out_of_range();
+    }
+    constexpr byte _merge(byte old, byte offset) const {
+        return (offset < 4) ? (byte)((old & ~(_mask >> (offset<<3))) | ((_value & _mask) >> (offset<<3))) : old;
+    }
+    constexpr byte _freeSlot(byte slot) const {
+        return (slot > 4 || (reg((slot<<1)+50) & 0b00001111) == 0) ? slot : _freeSlot(slot+1);
+    }
+    constexpr BuzzKillPreset<BuzzKillPreset> _addPatch(byte slot, byte srcMod, byte destVoice, buzzkill_patch_t patchType, byte patchParam) const {
+        return BuzzKillPreset<BuzzKillPreset>(*this, (slot<<1)+50,
+            _check(slot <= 4 && srcMod <= 3 && destVoice <= 3 && patchType <= 15 && patchType != BUZZKILL_PATCH_NONE,
+                   (destVoice<<6 | srcMod<<4 | patchType) | (uint32_t)patchParam<<8),
+            0xffff);
+    }
+    template <byte... Index> constexpr buzzkill_preset_t _image(_buzzkill_indices<Index...>) const {
+        return buzzkill_preset_t{{ reg(Index)... }};
+    }
 };
 
 #endif // BUZZKILL_H
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillAutomation.h>
+
+const byte BuzzKillAutomation::_sineTable[65] PROGMEM = {
+  0, 6, 13, 19, 25, 31, 37, 44, 50, 56, 62, 68, 74, 80, 86, 92,
+  98, 103, 109, 115, 120, 126, 131, 136, 142, 147, 152, 157, 162, 167, 171, 176,
+  180, 185, 189, 193, 197, 201, 205, 208, 212, 215, 219, 222, 225, 228, 231, 233,
+  236, 238, 240, 242, 244, 246, 247, 249, 250, 251, 252, 253, 254, 254, 255, 255,
+  255
+};
+
+BuzzKillAutomation::BuzzKillAutomation(BuzzKill &buzzkill) : _buzzkill(buzzkill) {
+  for (byte index=0; index<BUZZKILL_AUTOMATION_LANES; ++index) _lanes[index].reg = 255;
+}
+
+void BuzzKillAutomation::setTickRate(word ticksPerSecond) {
+  if (ticksPerSecond == 0 || ticksPerSecond > 1000) return;
+  _tickMicros = 1000000UL / ticksPerSecond;
+}
+
+bool BuzzKillAutomation::sweepFrequency(buzzkill_osctype_t oscType, byte oscNum, word fromFreq16, word toFreq16, word timeMillis, bool exponential) {
+  if (oscNum > 3) return false;
+  byte reg = oscType + (oscNum<<2);
+  if (!exponential) return _start(reg, _RAMP, fromFreq16, toFreq16, timeMillis);
+  long from = _frequencyToCents(fromFreq16), to = _frequencyToCents(toFreq16);
+  if (from < 0 || to < 0) return false;
+  return _start(reg, _RAMP_CENTS, from, to, timeMillis);
+}
+
+bool BuzzKillAutomation::glideFrequency(buzzkill_osctype_t oscType, byte oscNum, word toFreq16, word timeMillis, bool exponential) {
+  if (oscNum > 3) return false;
+  return sweepFrequency(oscType, oscNum, _current(oscType + (oscNum<<2)), toFreq16, timeMillis, exponential);
+}
+
+bool BuzzKillAutomation::glideNote(buzzkill_osctype_t oscType, byte oscNum, byte note, word timeMillis, int cents) {
+  long to = note * 100L + cents;
+  if (oscNum > 3 || to < 0 || to > 10700) return false;
+  byte reg = oscType + (oscNum<<2);
+  long from = _frequencyToCents(_current(reg));
+  // With no pitch to glide from (e.g. a frequency of 0), the note is set at once
+  if (from < 0) return _start(reg, _RAMP_CENTS, to, to, 0);
+  return _start(reg, _RAMP_CENTS, from, to, timeMillis);
+}
+
+bool BuzzKillAutomation::fadeMidpoint(buzzkill_osctype_t oscType, byte oscNum, byte midpoint, word timeMillis) {
+  if (oscNum > 3) return false;
+  byte reg = oscType + (oscNum<<2) + 2;
+  return _start(reg, _RAMP, _current(reg), midpoint, timeMillis);
+}
+
+bool BuzzKillAutomation::fadeMixVolume(byte envNum, byte mixVol, word timeMillis) {
+  if (envNum > 3 || mixVol > 15) return false;
+  byte reg = (envNum<<2) + 35;
+  return _start(reg, _RAMP, _current(reg), mixVol, timeMillis);
+}
+
+bool BuzzKillAutomation::fadeMasterVolume(byte volume, word timeMillis) {
+  if (volume > 15) return false;
+  return _start(48, _RAMP, _current(48), volume, timeMillis);
+}
+
+bool BuzzKillAutomation::addVibrato(buzzkill_osctype_t oscType, byte oscNum, word rate16, word depthCents, buzzkill_shape_t shape) {
+  if (oscNum > 3 || depthCents > 1200) return false;
+  return _startLFO(oscType + (oscNum<<2), _LFO_CENTS, rate16, depthCents, shape);
+}
+
+bool BuzzKillAutomation::addMidpointLFO(buzzkill_osctype_t oscType, byte oscNum, word rate16, byte depth, buzzkill_shape_t shape) {
+  if (oscNum > 3) return false;
+  return _startLFO(oscType + (oscNum<<2) + 2, _LFO, rate16, depth, shape);
+}
+
+bool BuzzKillAutomation::addMixVolumeLFO(byte envNum, word rate16, byte depth, buzzkill_shape_t shape) {
+  if (envNum > 3 || depth > 15) return false;
+  return _startLFO((envNum<<2) + 35, _LFO, rate16, depth, shape);
+}
+
+void BuzzKillAutomation::cancel(byte reg) {
+  for (byte index=0; index<BUZZKILL_AUTOMATION_LANES; ++index) {
+    _Lane &lane = _lanes[index];
+    if (lane.reg != reg) continue;
+    if (lane.mode == _LFO || lane.mode == _LFO_CENTS) _write(reg, lane.from, lane.mode == _LFO_CENTS);
+    lane.reg = 255;
+  }
+}
+
+void BuzzKillAutomation::cancelAll() {
+  _buzzkill.beginBatch();
+  for (byte index=0; index<BUZZKILL_AUTOMATION_LANES; ++index) {
+    if (_lanes[index].reg != 255) cancel(_lanes[index].reg);
+  }
+  _buzzkill.commitBatch();
+}
+
+void BuzzKillAutomation::poll() {
+  unsigned long now = micros(), elapsed = now - _lastTick;
+  // While nothing is running, keep the clock current so that the first update measures from the start of the change
+  if (!isActive()) {
+    _lastTick = now;
+    return;
+  }
+  if (elapsed < _tickMicros) return;
+  _lastTick = now;
+  _tick(now, elapsed);
+}
+
+bool BuzzKillAutomation::isActive() {
+  for (byte index=0; index<BUZZKILL_AUTOMATION_LANES; ++index) {
+    if (_lanes[index].reg != 255) return true;
+  }
+  return false;
+}
+
+long BuzzKillAutomation::_frequencyToCents(word freq16) {
+  // The inverse of noteToFrequency(), which interpolates linearly between semitones; -1 if below note 0
+  byte low = 0, high = 107, mid;
+  word lowFreq, highFreq;
+  if (freq16 < BuzzKill::noteToFrequency(0)) return -1;
+  if (freq16 >= BuzzKill::noteToFrequency(107)) return 10700;
+  while (high - low > 1) {
+    mid = (low + high) / 2;
+    if (BuzzKill::noteToFrequency(mid) <= freq16) low = mid; else high = mid;
+  }
+  lowFreq = BuzzKill::noteToFrequency(low);
+  highFreq = BuzzKill::noteToFrequency(high);
+  return low * 100L + ((freq16 - lowFreq) * 100L + (highFreq - lowFreq) / 2) / (highFreq - lowFreq);
+}
+
+int BuzzKillAutomation::_wave(buzzkill_shape_t shape, word phase) {
+  // Each shape runs from -256 to 256, starting from the centre where it has one
+  byte quarter, index;
+  int value;
+  switch (shape) {
+    case BUZZKILL_SHAPE_RAMP:
+      return (int)(phase >> 7) - 256;
+    case BUZZKILL_SHAPE_TRIANGLE:
+      phase += 16384;
+      return (phase < 32768) ? (int)(phase >> 6) - 256 : 767 - (int)(phase >> 6);
+    case BUZZKILL_SHAPE_PULSE:
+      return (phase < 32768) ? 256 : -256;
+    default:
+      quarter = phase >> 14;
+      index = (phase >> 8) & 63;
+      value = pgm_read_byte(&_sineTable[(quarter & 1) ? 64 - index : index]);
+      return (quarter & 2) ? -value : value;
+  }
+}
+
+long BuzzKillAutomation::_current(byte reg) {
+  const byte *shadows = _buzzkill._shadows;
+  if (reg < 32 && (reg & 3) == 0) return shadows[reg] | ((word)shadows[reg+1] << 8);
+  if (reg < 32) return shadows[reg];
+  return shadows[reg] >> 4;
+}
+
+BuzzKillAutomation::_Lane *BuzzKillAutomation::_claim(byte reg) {
+  // The lane already changing this register, otherwise the first free lane
+  _Lane *free = nullptr;
+  for (byte index=0; index<BUZZKILL_AUTOMATION_LANES; ++index) {
+    if (_lanes[index].reg == reg) return &_lanes[index];
+    if (!free && _lanes[index].reg == 255) free = &_lanes[index];
+  }
+  return free;
+}
+
+bool BuzzKillAutomation::_start(byte reg, _Mode mode, long from, long to, word timeMillis) {
+  _Lane *lane = _claim(reg);
+  // A change with no length is made at once, so it needs no lane, but stops anything else changing the register
+  if (timeMillis == 0) {
+    if (lane && lane->reg == reg) lane->reg = 255;
+    _write(reg, to, mode == _RAMP_CENTS);
+    return true;
+  }
+  if (!lane) return false;
+  lane->reg = reg;
+  lane->mode = mode;
+  lane->from = from;
+  lane->to = to;
+  lane->start = micros();
+  lane->duration = timeMillis;
+  _write(reg, from, mode == _RAMP_CENTS);
+  return true;
+}
+
+bool BuzzKillAutomation::_startLFO(byte reg, _Mode mode, word rate16, long depth, buzzkill_shape_t shape) {
+  if (shape != BUZZKILL_SHAPE_SINE && shape != BUZZKILL_SHAPE_RAMP && shape != BUZZKILL_SHAPE_TRIANGLE && shape != BUZZKILL_SHAPE_PULSE) return false;
+  _Lane *lane = _claim(reg);
+  if (!lane) return false;
+  // An LFO started over another one keeps the same centre, rather than starting from wherever the first had reached
+  bool same = (lane->reg == reg && lane->mode == mode);
+  long centre = same ? lane->from : _current(reg);
+  if (!same && mode == _LFO_CENTS) centre = _frequencyToCents(centre);
+  if (centre < 0) return false;
+  lane->reg = reg;
+  lane->mode = mode;
+  lane->shape = shape;
+  lane->from = centre;
+  lane->to = depth;
+  lane->rate = rate16;
+  lane->phase = lane->phasePart = 0;
+  _write(reg, centre + depth * _wave(shape, 0) / 256, mode == _LFO_CENTS);
+  return true;
+}
+
+long BuzzKillAutomation::_limit(long value, long high) {
+  return (value < 0) ? 0 : (value > high) ? high : value;
+}
+
+void BuzzKillAutomation::_write(byte reg, long value, bool cents) {
+  buzzkill_osctype_t oscType = (buzzkill_osctype_t)(reg & BUZZKILL_OSCTYPE_VOICE);
+  byte oscNum = (reg >> 2) & 3;
+  if (reg < 32 && (reg & 3) == 0) {
+    if (cents) value = BuzzKill::noteToFrequency(0, _limit(value, 10700));
+    _buzzkill.setFrequencyRaw(oscType, oscNum, _limit(value, 65535L));
+  }
+  else if (reg < 32) _buzzkill.setMidpoint(oscType, oscNum, _limit(value, 255));
+  else if (reg < 48) _buzzkill.setMixVolume((reg - 35) >> 2, _limit(value, 15));
+  else _buzzkill.setMasterVolume(_limit(value, 15));
+}
+
+void BuzzKillAutomation::_tick(unsigned long now, unsigned long elapsed) {
+  unsigned long time, step, part;
+  // An update that comes very late moves an LFO on by at most 65 ms, keeping the arithmetic below within 32 bits
+  if (elapsed > 65535) elapsed = 65535;
+  _buzzkill.beginBatch();
+  for (byte index=0; index<BUZZKILL_AUTOMATION_LANES; ++index) {
+    _Lane &lane = _lanes[index];
+    if (lane.reg == 255) continue;
+    if (lane.mode == _RAMP || lane.mode == _RAMP_CENTS) {
+      time = (now - lane.start) / 1000;
+      if (time >= lane.duration) {
+        _write(lane.reg, lane.to, lane.mode == _RAMP_CENTS);
+        lane.reg = 255;
+        continue;
+      }
+      // Fraction of the ramp completed, to 12 bits
+      part = (time << 12) / lane.duration;
+      _write(lane.reg, lane.from + (lane.to - lane.from) * (long)part / 4096, lane.mode == _RAMP_CENTS);
+      continue;
+    }
+    // The phase advances by 65536 per cycle: elapsed * rate / 16 / 1000000 cycles, or elapsed * rate * 64 / 15625,
+    // carrying the remainder so that the LFO rate is exact
+    step = elapsed * lane.rate;
+    part = (step % 15625) * 64 + lane.phasePart;
+    lane.phase += (step / 15625) * 64 + part / 15625;
+    lane.phasePart = part % 15625;
+    _write(lane.reg, lane.from + lane.to * _wave(lane.shape, lane.phase) / 256, lane.mode == _LFO_CENTS);
+  }
+  _buzzkill.commitBatch();
+}
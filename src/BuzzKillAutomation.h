@@ -0,0 +1,248 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_AUTOMATION_H
+#define BUZZKILL_AUTOMATION_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+
+// Most glides, fades and LFOs that can run at once
+#define BUZZKILL_AUTOMATION_LANES 8
+// Default number of updates per second
+#define BUZZKILL_AUTOMATION_RATE 100
+
+/**
+ * Changes registers smoothly over time from the library side, adding to the board's own modulation without using
+ * its mod oscillators or patch slots: frequency glides and sweeps (linear, or exponential for an even change in pitch),
+ * portamento between notes, fades of midpoint and volume, and software LFOs for frequency (vibrato), midpoint and
+ * mix volume (tremolo). Each running change uses one lane, tied to the register it changes; starting another change
+ * on the same register replaces it. At each update, only registers whose values have changed are sent, in one batch.
+ * poll() must be called frequently, e.g. from loop().
+ *
+ *     BuzzKillAutomation automation(buzzkill);
+ *     automation.glideNote(BUZZKILL_OSCTYPE_VOICE, 0, 72, 300);             // portamento up an octave over 300 ms
+ *     automation.addVibrato(BUZZKILL_OSCTYPE_VOICE, 1, 96, 30);             // 6 Hz, +/- 30 cents
+ *     automation.fadeMasterVolume(0, 2000);                                 // fade out over 2 seconds
+ *     // then call automation.poll() from loop()
+ */
+class BuzzKillAutomation {
+public:
+    /**
+     * Constructor.
+     * @param buzzkill       The BuzzKill object for the board
+     */
+    BuzzKillAutomation(BuzzKill &buzzkill);
+
+
+    /**
+     * Set how often registers are updated while changes are running.
+     * Faster rates give smoother changes, at the cost of more bus traffic.
+     * @param ticksPerSecond The number of updates per second (1..1000); defaults to 100
+     */
+    void setTickRate(word ticksPerSecond);
+
+
+    /**
+     * Sweep the frequency of an oscillator between two values.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param fromFreq16     The starting frequency in 1/16ths of a hertz, e.g. 7040 for 440 Hz
+     * @param toFreq16       The ending frequency in 1/16ths of a hertz
+     * @param timeMillis     The length of the sweep in milliseconds (0..65535)
+     * @param exponential    (optional) Whether the pitch changes evenly (true), rather than the frequency (false);
+     *                       defaults to false. Exponential sweeps need both frequencies within the range of MIDI notes 0..107.
+     * @return               True if the sweep was started, false if the values are invalid or all lanes are in use
+     */
+    bool sweepFrequency(buzzkill_osctype_t oscType,
+                        byte oscNum,
+                        word fromFreq16,
+                        word toFreq16,
+                        word timeMillis,
+                        bool exponential=false);
+
+
+    /**
+     * Glide the frequency of an oscillator from its current value to a new one.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param toFreq16       The ending frequency in 1/16ths of a hertz
+     * @param timeMillis     The length of the glide in milliseconds (0..65535)
+     * @param exponential    (optional) Whether the pitch changes evenly (true), rather than the frequency (false); defaults to true
+     * @return               True if the glide was started, false if the values are invalid or all lanes are in use
+     */
+    bool glideFrequency(buzzkill_osctype_t oscType,
+                        byte oscNum,
+                        word toFreq16,
+                        word timeMillis,
+                        bool exponential=true);
+
+
+    /**
+     * Glide the frequency of an oscillator from its current value to a musical note (portamento).
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param note           The MIDI note number (0..107), e.g. 60 for middle C
+     * @param timeMillis     The length of the glide in milliseconds (0..65535)
+     * @param cents          (optional) Offset from the note in cents, may be negative
+     * @return               True if the glide was started, false if the values are invalid or all lanes are in use
+     */
+    bool glideNote(buzzkill_osctype_t oscType,
+                   byte oscNum,
+                   byte note,
+                   word timeMillis,
+                   int cents=0);
+
+
+    /**
+     * Fade the midpoint of an oscillator from its current value to a new one.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param midpoint       The ending midpoint value (0..255)
+     * @param timeMillis     The length of the fade in milliseconds (0..65535)
+     * @return               True if the fade was started, false if the values are invalid or all lanes are in use
+     */
+    bool fadeMidpoint(buzzkill_osctype_t oscType,
+                      byte oscNum,
+                      byte midpoint,
+                      word timeMillis);
+
+
+    /**
+     * Fade the mix volume of an envelope from its current value to a new one.
+     * @param envNum         The envelope number (0..3)
+     * @param mixVol         The ending mix volume (0..15)
+     * @param timeMillis     The length of the fade in milliseconds (0..65535)
+     * @return               True if the fade was started, false if the values are invalid or all lanes are in use
+     */
+    bool fadeMixVolume(byte envNum,
+                       byte mixVol,
+                       word timeMillis);
+
+
+    /**
+     * Fade the master volume from its current value to a new one.
+     * @param volume         The ending master volume (0..15)
+     * @param timeMillis     The length of the fade in milliseconds (0..65535)
+     * @return               True if the fade was started, false if the values are invalid or all lanes are in use
+     */
+    bool fadeMasterVolume(byte volume,
+                          word timeMillis);
+
+
+    /**
+     * Start a software LFO varying the frequency of an oscillator (vibrato), around its current pitch.
+     * The current frequency must be within the range of MIDI notes 0..107.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param rate16         The LFO rate in 1/16ths of a hertz, e.g. 96 for 6 Hz
+     * @param depthCents     How far the pitch moves either way, in cents (0..1200)
+     * @param shape          (optional) The LFO shape (BUZZKILL_SHAPE_SINE, _RAMP, _TRIANGLE or _PULSE); defaults to sine
+     * @return               True if the LFO was started, false if the values are invalid or all lanes are in use
+     */
+    bool addVibrato(buzzkill_osctype_t oscType,
+                    byte oscNum,
+                    word rate16,
+                    word depthCents,
+                    buzzkill_shape_t shape=BUZZKILL_SHAPE_SINE);
+
+
+    /**
+     * Start a software LFO varying the midpoint of an oscillator, around its current value.
+     * @param oscType        The oscillator type (BUZZKILL_OSCTYPE_MOD or BUZZKILL_OSCTYPE_VOICE)
+     * @param oscNum         The oscillator number (0..3) within the specified type
+     * @param rate16         The LFO rate in 1/16ths of a hertz
+     * @param depth          How far the midpoint moves either way (0..255); the result is limited to 0..255
+     * @param shape          (optional) The LFO shape (BUZZKILL_SHAPE_SINE, _RAMP, _TRIANGLE or _PULSE); defaults to sine
+     * @return               True if the LFO was started, false if the values are invalid or all lanes are in use
+     */
+    bool addMidpointLFO(buzzkill_osctype_t oscType,
+                        byte oscNum,
+                        word rate16,
+                        byte depth,
+                        buzzkill_shape_t shape=BUZZKILL_SHAPE_SINE);
+
+
+    /**
+     * Start a software LFO varying the mix volume of an envelope (tremolo), around its current value.
+     * @param envNum         The envelope number (0..3)
+     * @param rate16         The LFO rate in 1/16ths of a hertz
+     * @param depth          How far the mix volume moves either way (0..15); the result is limited to 0..15
+     * @param shape          (optional) The LFO shape (BUZZKILL_SHAPE_SINE, _RAMP, _TRIANGLE or _PULSE); defaults to sine
+     * @return               True if the LFO was started, false if the values are invalid or all lanes are in use
+     */
+    bool addMixVolumeLFO(byte envNum,
+                         word rate16,
+                         byte depth,
+                         buzzkill_shape_t shape=BUZZKILL_SHAPE_SINE);
+
+
+    /**
+     * Stop any glide, fade or LFO changing a register. A glide or fade stops where it is; an LFO returns to its centre value.
+     * @param reg            The register number: the first frequency register of an oscillator (oscType + oscNum*4),
+     *                       its midpoint register (oscType + oscNum*4 + 2), a mix volume register (35 + envNum*4),
+     *                       or the master volume register (48)
+     */
+    void cancel(byte reg);
+
+
+    /**
+     * Stop all glides, fades and LFOs, as for cancel().
+     */
+    void cancelAll();
+
+
+    /**
+     * Update registers if an update is due.
+     */
+    void poll();
+
+
+    /**
+     * Check whether any glides, fades or LFOs are running.
+     * @return               True if any lane is in use
+     */
+    bool isActive();
+
+private:
+    enum _Mode: byte { _RAMP, _RAMP_CENTS, _LFO, _LFO_CENTS };
+
+    struct _Lane {
+        byte reg;                        // register changed, or 255 if the lane is free
+        _Mode mode;
+        buzzkill_shape_t shape;
+        long from;                       // ramp: starting value; LFO: centre value
+        long to;                         // ramp: ending value; LFO: depth
+        unsigned long start;             // micros() value at the start of a ramp
+        word duration;                   // length of a ramp, in milliseconds
+        word rate;                       // LFO rate, in 1/16ths of a hertz
+        word phase;                      // LFO phase; a full cycle is 65536
+        word phasePart;                  // fraction of the LFO phase carried between updates
+    };
+
+    // Quarter of a sine wave, scaled to 0..255
+    static const byte _sineTable[65] PROGMEM;
+
+    BuzzKill &_buzzkill;
+    _Lane _lanes[BUZZKILL_AUTOMATION_LANES];
+    unsigned long _tickMicros=1000000UL/BUZZKILL_AUTOMATION_RATE;
+    unsigned long _lastTick=0;
+    static long _frequencyToCents(word freq16);
+    static long _limit(long value, long high);
+    static int _wave(buzzkill_shape_t shape, word phase);
+    long _current(byte reg);
+    _Lane *_claim(byte reg);
+    bool _start(byte reg, _Mode mode, long from, long to, word timeMillis);
+    bool _startLFO(byte reg, _Mode mode, word rate16, long depth, buzzkill_shape_t shape);
+    void _write(byte reg, long value, bool cents);
+    void _tick(unsigned long now, unsigned long elapsed);
+};
+
+#endif // BUZZKILL_AUTOMATION_H
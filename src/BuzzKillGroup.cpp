@@ -0,0 +1,112 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillGroup.h>
+
+BuzzKillGroup::BuzzKillGroup(BuzzKill *boards[], byte count, BuzzKill *broadcast) : _boards(boards), _count(count), _broadcast(broadcast) {
+}
+
+byte BuzzKillGroup::boardCount() {
+  return _count;
+}
+
+BuzzKill &BuzzKillGroup::board(byte boardNum) {
+  return *_boards[boardNum < _count ? boardNum : 0];
+}
+
+byte BuzzKillGroup::voiceCount() {
+  return _count << 2;
+}
+
+BuzzKill &BuzzKillGroup::voiceBoard(byte voice) {
+  return board(voice >> 2);
+}
+
+void BuzzKillGroup::restartOscillators(byte restartMask) {
+  BUZZKILL_TRACE_API(RESTART_OSCILLATORS);
+  BuzzKill *board;
+  byte index, other;
+  _settle();
+  if (_broadcast) {
+    _broadcast->restartOscillators(restartMask);
+    _broadcast->flush();
+    return;
+  }
+  // Open the SPI transactions first, so that nothing but the commands themselves comes between the boards.
+  // Boards on the same bus share one transaction, since some cores do not allow it to be opened twice.
+  for (index=0; index<_count; ++index) {
+    board = _boards[index];
+    for (other=0; other<index && _boards[other]->_spi != board->_spi; ++other);
+    if (other < index && board->_spi) board->_joinSession(true); else board->beginSession();
+  }
+  for (index=0; index<_count; ++index) _boards[index]->_transmit(248, &restartMask, 1);
+  for (index=_count; index-- > 0; ) {
+    board = _boards[index];
+    for (other=0; other<index && _boards[other]->_spi != board->_spi; ++other);
+    if (other < index && board->_spi) board->_joinSession(false); else board->endSession();
+  }
+}
+
+void BuzzKillGroup::setNoteFrequency(byte voice, byte note, int cents) {
+  if (voice >= voiceCount()) return;
+  voiceBoard(voice).setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, voice & 3, note, cents);
+}
+
+void BuzzKillGroup::noteOn(byte voice, bool gate) {
+  if (voice >= voiceCount()) return;
+  voiceBoard(voice).noteOn(voice & 3, gate);
+}
+
+void BuzzKillGroup::noteOff(byte voice) {
+  noteOn(voice, false);
+}
+
+void BuzzKillGroup::flush() {
+  for (byte index=0; index<_count; ++index) _boards[index]->flush();
+}
+
+bool BuzzKillGroup::_beginBroadcast() {
+  if (!_broadcast || _count == 0) return false;
+  // A single transaction only suits every board if their contents are known to be the same
+  BuzzKill *first = _boards[0];
+  for (byte index=0; index<_count; ++index) {
+    BuzzKill *board = _boards[index];
+    if (board->_batchDepth || memcmp(board->_shadows, first->_shadows, 60) || memcmp(board->_known, first->_known, 8)) return false;
+  }
+  flush();
+  memcpy(_broadcast->_shadows, first->_shadows, 60);
+  memcpy(_broadcast->_known, first->_known, 8);
+  // The custom wave is only known if every board holds the same one
+  _broadcast->_waveSum = first->_waveSum;
+  _broadcast->_waveKnown = first->_waveKnown;
+  for (byte index=1; index<_count; ++index) {
+    if (!_boards[index]->_waveKnown || _boards[index]->_waveSum != first->_waveSum) _broadcast->_waveKnown = false;
+  }
+  return true;
+}
+
+void BuzzKillGroup::_endBroadcast() {
+  _broadcast->flush();
+  for (byte index=0; index<_count; ++index) {
+    memcpy(_boards[index]->_shadows, _broadcast->_shadows, 60);
+    memcpy(_boards[index]->_known, _broadcast->_known, 8);
+    _boards[index]->_waveSum = _broadcast->_waveSum;
+    _boards[index]->_waveKnown = _broadcast->_waveKnown;
+  }
+}
+
+void BuzzKillGroup::_settle() {
+  // Send any batched updates and queued commands for every board
+  for (byte index=0; index<_count; ++index) {
+    BuzzKill *board = _boards[index];
+    if (board->_batchDepth) board->_flushBatch();
+    board->flush();
+  }
+}
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_GROUP_H
+#define BUZZKILL_GROUP_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+
+/**
+ * Drives several BuzzKill boards together: identical changes can be broadcast to every board, the voices of all boards
+ * form a single pool (voices 0-3 are on the first board, 4-7 on the second, and so on), and oscillators on all boards
+ * can be restarted together so that they stay in phase. Each board is set up as usual, with its own BuzzKill object.
+ *
+ * Boards on a shared SPI bus may also be wired to a common select pin, so that driving that pin low selects every board
+ * at once (e.g. each board's SS input driven through an AND gate from its own pin and the common pin). A BuzzKill object
+ * set up with beginSPI() on the common pin can then be given to the group, which uses it to send broadcasts as a single
+ * transaction whenever the boards hold identical register contents.
+ *
+ *     BuzzKill *boards[] = { &buzzkill1, &buzzkill2 };
+ *     BuzzKillGroup group(boards, 2);
+ *     group.broadcast([](BuzzKill &buzzkill) {
+ *         buzzkill.setShape(BUZZKILL_OSCTYPE_VOICE, 0, BUZZKILL_SHAPE_TRIANGLE);
+ *         buzzkill.enableVoice(0);
+ *     });
+ */
+class BuzzKillGroup {
+public:
+    /**
+     * Constructor.
+     * @param boards         An array of pointers to the BuzzKill objects for each board; must remain valid while the group is used
+     * @param count          The number of boards (at least 1)
+     * @param broadcast      (optional) A BuzzKill object whose select pin selects every board at once; defaults to none
+     */
+    BuzzKillGroup(BuzzKill *boards[],
+                  byte count,
+                  BuzzKill *broadcast=nullptr);
+
+
+    /**
+     * Get the number of boards in the group.
+     */
+    byte boardCount();
+
+
+    /**
+     * Get the BuzzKill object for one board. An out-of-range board number gives the first board.
+     * @param boardNum       The board number (0..boardCount()-1)
+     */
+    BuzzKill &board(byte boardNum);
+
+
+    /**
+     * Get the total number of voices in the group (4 per board).
+     */
+    byte voiceCount();
+
+
+    /**
+     * Get the BuzzKill object for the board holding a voice from the pool.
+     * Use voice%4 as the voice/envelope number on that board.
+     * @param voice          The voice number within the pool (0..voiceCount()-1)
+     */
+    BuzzKill &voiceBoard(byte voice);
+
+
+    /**
+     * Make the same changes on every board. The action is called with a BuzzKill object, and may use any of its methods.
+     * If a broadcast object was given and all boards hold identical register contents, the action is carried out once
+     * and sent to every board together; otherwise it is carried out for each board in turn.
+     * Either way, register changes are batched, so each board receives as few bus transactions as possible.
+     * @param action         A function or lambda taking a BuzzKill& parameter
+     */
+    template <class Action>
+    void broadcast(Action action);
+
+
+    /**
+     * Restart oscillators on every board, as close to the same moment as possible.
+     * Pending updates and queued commands are sent first, so that the restart commands go out back to back;
+     * with a broadcast object, a single command restarts every board at once.
+     * @param restartMask    A binary mask; bits 0-3 correspond to mod oscillators 0-3, bits 4-7 to voice oscillators 0-3
+     */
+    void restartOscillators(byte restartMask);
+
+
+    /**
+     * Set the frequency of a voice oscillator from the pool, using a note number.
+     * @param voice          The voice number within the pool (0..voiceCount()-1)
+     * @param note           The MIDI note number (0..107), e.g. 60 for middle C
+     * @param cents          (optional) Fine tuning in cents; defaults to 0
+     */
+    void setNoteFrequency(byte voice,
+                          byte note,
+                          int cents=0);
+
+
+    /**
+     * Set the gate bit for the envelope of a voice from the pool.
+     * @param voice          The voice number within the pool (0..voiceCount()-1)
+     * @param gate           (optional) Whether to gate the note on or off (true/false); defaults to true
+     */
+    void noteOn(byte voice,
+                bool gate=true);
+
+
+    /**
+     * Clear the gate bit for the envelope of a voice from the pool.
+     * @param voice          The voice number within the pool (0..voiceCount()-1)
+     */
+    void noteOff(byte voice);
+
+
+    /**
+     * Send all queued commands for every board, waiting until they are complete.
+     */
+    void flush();
+
+private:
+    BuzzKill **_boards;
+    byte _count;
+    BuzzKill *_broadcast;
+    bool _beginBroadcast();
+    void _endBroadcast();
+    void _settle();
+};
+
+template <class Action>
+void BuzzKillGroup::broadcast(Action action) {
+    if (_beginBroadcast()) {
+        _broadcast->beginBatch();
+        action(*_broadcast);
+        _broadcast->commitBatch();
+        _endBroadcast();
+        return;
+    }
+    for (byte index=0; index<_count; ++index) {
+        _boards[index]->beginBatch();
+        action(*_boards[index]);
+        _boards[index]->commitBatch();
+    }
+}
+
+#endif // BUZZKILL_GROUP_H
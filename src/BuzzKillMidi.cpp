@@ -0,0 +1,265 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillMidi.h>
+
+BuzzKillMidi::BuzzKillMidi(BuzzKillPoly &poly) : _poly(poly) {
+}
+
+bool BuzzKillMidi::begin(const byte data[], unsigned long length) {
+  stop();
+  _data = data;
+  _reader = nullptr;
+  _length = length;
+  return _load();
+}
+
+bool BuzzKillMidi::begin(buzzkill_midi_reader_t reader, unsigned long length) {
+  stop();
+  _data = nullptr;
+  _reader = reader;
+  _length = length;
+  return _load();
+}
+
+void BuzzKillMidi::setChannels(word channelMask) {
+  _channels = channelMask;
+}
+
+void BuzzKillMidi::play(bool repeat) {
+  if (_trackCount == 0) return;
+  stop();
+  _repeat = repeat;
+  _rewind();
+  _start = micros();
+  _playing = true;
+}
+
+void BuzzKillMidi::stop() {
+  if (!_playing) return;
+  _playing = false;
+  _poly.allNotesOff();
+  _poly.pitchBend(0);
+}
+
+void BuzzKillMidi::poll() {
+  if (!_playing) return;
+  unsigned long now = micros() - _start;
+  unsigned long time;
+  word remainder;
+  byte index, next;
+  while (true) {
+    // Tracks are merged by always taking the earliest event; tempo changes apply from their own tick onward
+    next = 255;
+    for (index=0; index<_trackCount; ++index) {
+      if (!_tracks[index].done && (next == 255 || _tracks[index].tick < _tracks[next].tick)) next = index;
+    }
+    if (next == 255) {
+      if (!_repeat) {
+        stop();
+        return;
+      }
+      // Start again from the time the song ended, rather than from now, so that repeats keep in time
+      if (_tickMicros == 0) {
+        stop();
+        return;
+      }
+      _start += _tickMicros;
+      now -= _tickMicros;
+      _rewind();
+      continue;
+    }
+    time = _microsAt(_tracks[next].tick, remainder);
+    if ((long)(now - time) < 0) return;
+    _tick = _tracks[next].tick;
+    _tickMicros = time;
+    _remainder = remainder;
+    _event(_tracks[next]);
+  }
+}
+
+bool BuzzKillMidi::isPlaying() {
+  return _playing;
+}
+
+bool BuzzKillMidi::_load() {
+  byte header[14];
+  unsigned long position, length;
+  _trackCount = 0;
+  if (_read(0, header, 14) < 14 || memcmp(header, "MThd", 4) != 0) return false;
+  length = ((unsigned long)header[4] << 24) | ((unsigned long)header[5] << 16) | ((word)header[6] << 8) | header[7];
+  if (header[8] != 0 || header[9] > 1) return false;
+  _division = ((word)header[12] << 8) | header[13];
+  _smpte = (_division & 0x8000);
+  // SMPTE timing counts ticks per frame, which is handled as a fixed tempo of one second per (frames * ticks)
+  if (_smpte) _division = (byte)(-(int8_t)header[12]) * (word)header[13];
+  if (_division == 0) return false;
+  // Find the start of each track, skipping any other kinds of chunk
+  position = 8 + length;
+  while (position + 8 <= _length && _trackCount < BUZZKILL_MIDI_TRACKS) {
+    if (_read(position, header, 8) < 8) break;
+    length = ((unsigned long)header[4] << 24) | ((unsigned long)header[5] << 16) | ((word)header[6] << 8) | header[7];
+    if (memcmp(header, "MTrk", 4) == 0) {
+      _starts[_trackCount] = position + 8;
+      _tracks[_trackCount++].end = (position + 8 + length < _length) ? position + 8 + length : _length;
+    }
+    position += 8 + length;
+  }
+  return _trackCount > 0;
+}
+
+word BuzzKillMidi::_read(unsigned long position, byte buffer[], word length) {
+  if (position >= _length) return 0;
+  if (length > _length - position) length = _length - position;
+  if (_reader) return _reader(position, buffer, length);
+  memcpy_P(buffer, _data + position, length);
+  return length;
+}
+
+void BuzzKillMidi::_rewind() {
+  _setTempo(_smpte ? 1000000 : 500000);
+  _tick = _tickMicros = _remainder = 0;
+  for (byte index=0; index<_trackCount; ++index) {
+    _Track &track = _tracks[index];
+    track.position = _starts[index];
+    track.tick = 0;
+    track.status = 0;
+    track.bufferPos = track.bufferLength = 0;
+    track.done = false;
+    _readDelta(track);
+  }
+}
+
+int BuzzKillMidi::_readByte(_Track &track) {
+  if (track.bufferPos == track.bufferLength) {
+    word length = BUZZKILL_MIDI_BUFFER;
+    if (track.position >= track.end) return -1;
+    if (length > track.end - track.position) length = track.end - track.position;
+    track.bufferLength = _read(track.position, track.buffer, length);
+    track.bufferPos = 0;
+    track.position += track.bufferLength;
+    if (track.bufferLength == 0) return -1;
+  }
+  return track.buffer[track.bufferPos++];
+}
+
+unsigned long BuzzKillMidi::_readNumber(_Track &track) {
+  // Variable-length quantity: 7 bits per byte, most significant first, with the top bit set on all but the last
+  unsigned long number = 0;
+  int value;
+  for (byte count=0; count<4; ++count) {
+    if ((value = _readByte(track)) < 0) {
+      track.done = true;
+      break;
+    }
+    number = (number << 7) | (value & 127);
+    if (value < 128) break;
+  }
+  return number;
+}
+
+void BuzzKillMidi::_skip(_Track &track, unsigned long count) {
+  // Skip what is left in the buffer, then move the file position past the rest
+  byte buffered = track.bufferLength - track.bufferPos;
+  if (count <= buffered) {
+    track.bufferPos += count;
+    return;
+  }
+  track.position += count - buffered;
+  track.bufferPos = track.bufferLength = 0;
+}
+
+void BuzzKillMidi::_readDelta(_Track &track) {
+  track.tick += _readNumber(track);
+  if (track.position >= track.end && track.bufferPos == track.bufferLength) track.done = true;
+}
+
+void BuzzKillMidi::_setTempo(unsigned long tempo) {
+  // Tempo is in microseconds per quarter note; splitting it by the division keeps _microsAt() within 32 bits
+  _tempoWhole = tempo / _division;
+  _tempoPart = tempo % _division;
+}
+
+unsigned long BuzzKillMidi::_microsAt(unsigned long tick, word &remainder) {
+  // Exact conversion of ticks since the last event, carrying the fraction of a microsecond so that timing never drifts
+  unsigned long ticks = tick - _tick;
+  unsigned long part = (ticks % _division) * _tempoPart + _remainder;
+  remainder = part % _division;
+  return _tickMicros + ticks * _tempoWhole + (ticks / _division) * _tempoPart + part / _division;
+}
+
+void BuzzKillMidi::_event(_Track &track) {
+  int value = _readByte(track);
+  byte status, data1 = 0, data2 = 0;
+  unsigned long length;
+  if (value < 0) {
+    track.done = true;
+    return;
+  }
+  if (value >= 128) {
+    status = value;
+    // Meta and system exclusive events cancel running status
+    track.status = (status < 0xf0) ? status : 0;
+    value = _readByte(track);
+  }
+  // A data byte first means the previous status byte is repeated (running status)
+  else status = track.status;
+  if (status == 0xff) {
+    byte type = value;
+    length = _readNumber(track);
+    if (type == 0x2f) {
+      track.done = true;
+      return;
+    }
+    if (type == 0x51 && length == 3 && !_smpte) {
+      unsigned long tempo = (unsigned long)_readByte(track) << 16;
+      tempo |= (word)_readByte(track) << 8;
+      tempo |= _readByte(track);
+      _setTempo(tempo);
+    }
+    else _skip(track, length);
+  }
+  else if (status == 0xf0 || status == 0xf7) {
+    // System exclusive: the byte already read is the start of the length
+    length = value & 127;
+    while (value >= 128 && (value = _readByte(track)) >= 0) length = (length << 7) | (value & 127);
+    _skip(track, length);
+  }
+  else if (status >= 0x80 && status < 0xf0) {
+    data1 = value;
+    if ((status & 0xe0) != 0xc0) data2 = _readByte(track);
+    if (_channels & (1U << (status & 15))) {
+      switch (status >> 4) {
+        case 0x9:
+          // Note on with velocity 0 is a note off
+          if (data2 > 0) _poly.noteOn(data1, data2);
+          else _poly.noteOff(data1);
+          break;
+        case 0x8:
+          _poly.noteOff(data1);
+          break;
+        case 0xb:
+          // All sound off, all notes off
+          if (data1 == 120 || data1 == 123) _poly.allNotesOff();
+          break;
+        case 0xe:
+          // The usual range of +/- 2 semitones
+          _poly.pitchBend(((((int)data2 << 7) | data1) - 8192) * 25L / 1024);
+          break;
+      }
+    }
+  }
+  else {
+    // A data byte with no status to repeat, or a message that does not belong in a file; the track cannot be followed
+    track.done = true;
+    return;
+  }
+  if (!track.done) _readDelta(track);
+}
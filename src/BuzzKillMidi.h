@@ -0,0 +1,142 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_MIDI_H
+#define BUZZKILL_MIDI_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+#include <BuzzKillPoly.h>
+
+// Most tracks played from a file; any further tracks are ignored
+#define BUZZKILL_MIDI_TRACKS 8
+// Bytes read ahead for each track
+#define BUZZKILL_MIDI_BUFFER 8
+
+// Reads part of a MIDI file, e.g. from an SD card; returns the number of bytes read
+typedef word (*buzzkill_midi_reader_t)(unsigned long position, byte buffer[], word length);
+
+/**
+ * Plays a Standard MIDI File (format 0 or 1), stored in program memory or read in small pieces from elsewhere, such as
+ * an SD card. Only a few bytes of each track are held in memory at a time. Notes are played on the voices of
+ * a BuzzKillPoly object, with timing following the tempo changes in the file. Pitch bends are applied to all notes.
+ * Other events (program changes, controllers, etc.) are ignored, so the voices are set up beforehand as for BuzzKillPoly.
+ * Channel 10 is left out by default, since it usually holds drums. poll() must be called frequently, e.g. from loop().
+ *
+ *     BuzzKillMidi midi(poly);
+ *     midi.begin(song, sizeof(song));     // const byte song[] PROGMEM = { 'M', 'T', 'h', 'd', ... };
+ *     midi.play();
+ *     // then call midi.poll() from loop()
+ */
+class BuzzKillMidi {
+public:
+    /**
+     * Constructor.
+     * @param poly           The BuzzKillPoly object which will play the notes
+     */
+    BuzzKillMidi(BuzzKillPoly &poly);
+
+
+    /**
+     * Load a MIDI file stored in program memory. Stops any song playing.
+     * @param data           The contents of the file, which must be declared PROGMEM
+     * @param length         The length of the file in bytes
+     * @return               True if successful, false if the data is not a MIDI file the player can use
+     */
+    bool begin(const byte data[],
+               unsigned long length);
+
+
+    /**
+     * Load a MIDI file read through a function supplied by the caller. Stops any song playing.
+     * For a file on an SD card, the function might be: file.seek(position); return file.read(buffer, length);
+     * @param reader         A function which reads part of the file into a buffer, returning the number of bytes read
+     * @param length         The length of the file in bytes
+     * @return               True if successful, false if the data is not a MIDI file the player can use
+     */
+    bool begin(buzzkill_midi_reader_t reader,
+               unsigned long length);
+
+
+    /**
+     * Choose which MIDI channels are played.
+     * @param channelMask    A binary mask; bit 0 corresponds to MIDI channel 1, through bit 15 for channel 16
+     */
+    void setChannels(word channelMask);
+
+
+    /**
+     * Start playing the song from the beginning.
+     * @param repeat         (optional) Whether to start again each time the song ends (true/false); defaults to false
+     */
+    void play(bool repeat=false);
+
+
+    /**
+     * Stop playing, releasing all notes.
+     */
+    void stop();
+
+
+    /**
+     * Play any events that are now due. Events are played late if poll() is called late, but the song does not drift.
+     */
+    void poll();
+
+
+    /**
+     * Check whether a song is playing.
+     * @return               True from play() until the end of the song (or stop())
+     */
+    bool isPlaying();
+
+private:
+    struct _Track {
+        unsigned long position;          // file position of the next byte to be read into the buffer
+        unsigned long end;               // file position of the end of the track
+        unsigned long tick;              // time of the next event, in ticks from the start of the song
+        byte status;                     // running status
+        byte buffer[BUZZKILL_MIDI_BUFFER];
+        byte bufferPos;
+        byte bufferLength;
+        bool done;
+    };
+
+    BuzzKillPoly &_poly;
+    const byte *_data=nullptr;
+    buzzkill_midi_reader_t _reader=nullptr;
+    unsigned long _length=0;
+    _Track _tracks[BUZZKILL_MIDI_TRACKS];
+    unsigned long _starts[BUZZKILL_MIDI_TRACKS];
+    byte _trackCount=0;
+    word _division=0;
+    bool _smpte=false;
+    word _channels=0xfdff;
+    bool _playing=false;
+    bool _repeat=false;
+    unsigned long _tempoWhole;
+    word _tempoPart;
+    unsigned long _tick;
+    unsigned long _tickMicros;
+    word _remainder;
+    unsigned long _start;
+    bool _load();
+    word _read(unsigned long position, byte buffer[], word length);
+    void _rewind();
+    int _readByte(_Track &track);
+    unsigned long _readNumber(_Track &track);
+    void _skip(_Track &track, unsigned long count);
+    void _readDelta(_Track &track);
+    void _setTempo(unsigned long tempo);
+    unsigned long _microsAt(unsigned long tick, word &remainder);
+    void _event(_Track &track);
+};
+
+#endif // BUZZKILL_MIDI_H
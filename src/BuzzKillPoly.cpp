@@ -0,0 +1,130 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillPoly.h>
+
+BuzzKillPoly::BuzzKillPoly(BuzzKill &buzzkill) : _buzzkill(&buzzkill) {
+  memset(_notes, 255, sizeof(_notes));
+  memset(_times, 0, sizeof(_times));
+  memset(_gates, 0, sizeof(_gates));
+}
+
+BuzzKillPoly::BuzzKillPoly(BuzzKillGroup &group) : _group(&group) {
+  _count = group.voiceCount() < BUZZKILL_POLY_VOICES ? group.voiceCount() : BUZZKILL_POLY_VOICES;
+  memset(_notes, 255, sizeof(_notes));
+  memset(_times, 0, sizeof(_times));
+  memset(_gates, 0, sizeof(_gates));
+}
+
+void BuzzKillPoly::useVoices(byte first, byte count) {
+  byte total = _group ? _group->voiceCount() : 4;
+  if (count == 0 || first + count > total || count > BUZZKILL_POLY_VOICES) return;
+  allNotesOff();
+  _first = first;
+  _count = count;
+  memset(_notes, 255, sizeof(_notes));
+  memset(_times, 0, sizeof(_times));
+  _clock = 0;
+}
+
+void BuzzKillPoly::setStealMode(buzzkill_steal_t mode) {
+  _stealMode = mode;
+}
+
+byte BuzzKillPoly::noteOn(byte note, byte velocity) {
+  if (note > 107 || velocity > 127) return 255;
+  if (velocity == 0) {
+    noteOff(note);
+    return 255;
+  }
+  byte index = _findVoice(note), voice = _first + index;
+  BuzzKill &board = _board(voice);
+  // The gate must be seen to go off and on again to restart the envelope
+  if (_gates[index]) _gate(voice, false);
+  board.beginBatch();
+  board.setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, voice & 3, note, _bend);
+  board.setMixVolume(voice & 3, 1 + (velocity * 14 + 63) / 127);
+  board.noteOn(voice & 3);
+  board.commitBatch();
+  _notes[index] = note;
+  _velocities[index] = velocity;
+  _times[index] = ++_clock;
+  _gates[index] = true;
+  return voice;
+}
+
+void BuzzKillPoly::noteOff(byte note) {
+  for (byte index=0; index<_count; ++index) {
+    if (_notes[index] != note || !_gates[index]) continue;
+    _gate(_first + index, false);
+    _gates[index] = false;
+    _times[index] = ++_clock;
+  }
+}
+
+void BuzzKillPoly::allNotesOff() {
+  _beginBatch();
+  for (byte index=0; index<_count; ++index) {
+    if (_gates[index]) _gate(_first + index, false);
+    _gates[index] = false;
+  }
+  _commitBatch();
+}
+
+void BuzzKillPoly::pitchBend(int cents) {
+  if (cents == _bend) return;
+  _bend = cents;
+  // Released voices are included, so that their release follows the bend too
+  _beginBatch();
+  for (byte index=0; index<_count; ++index) {
+    byte voice = _first + index;
+    if (_notes[index] != 255) _board(voice).setNoteFrequency(BUZZKILL_OSCTYPE_VOICE, voice & 3, _notes[index], _bend);
+  }
+  _commitBatch();
+}
+
+BuzzKill &BuzzKillPoly::_board(byte voice) {
+  return _group ? _group->voiceBoard(voice) : *_buzzkill;
+}
+
+byte BuzzKillPoly::_findVoice(byte note) {
+  byte index, best = 255;
+  // The voice already playing (or releasing) this note, so that a note is never doubled
+  for (index=0; index<_count; ++index) if (_notes[index] == note) return index;
+  // Otherwise the free voice released longest ago, since its envelope is likely to be quietest
+  for (index=0; index<_count; ++index) {
+    if (_gates[index]) continue;
+    if (best == 255 || (word)(_clock - _times[index]) > (word)(_clock - _times[best])) best = index;
+  }
+  if (best != 255) return best;
+  // Otherwise a sounding voice must be stolen; times are compared by age, so the counter may wrap around
+  best = 0;
+  for (index=1; index<_count; ++index) {
+    if (_stealMode == BUZZKILL_STEAL_QUIETEST && _velocities[index] != _velocities[best]) {
+      if (_velocities[index] < _velocities[best]) best = index;
+    }
+    else if ((word)(_clock - _times[index]) > (word)(_clock - _times[best])) best = index;
+  }
+  return best;
+}
+
+void BuzzKillPoly::_gate(byte voice, bool gate) {
+  _board(voice).noteOn(voice & 3, gate);
+}
+
+void BuzzKillPoly::_beginBatch() {
+  if (!_group) _buzzkill->beginBatch();
+  else for (byte boardNum=0; boardNum<_group->boardCount(); ++boardNum) _group->board(boardNum).beginBatch();
+}
+
+void BuzzKillPoly::_commitBatch() {
+  if (!_group) _buzzkill->commitBatch();
+  else for (byte boardNum=0; boardNum<_group->boardCount(); ++boardNum) _group->board(boardNum).commitBatch();
+}
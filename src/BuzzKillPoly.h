@@ -0,0 +1,120 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_POLY_H
+#define BUZZKILL_POLY_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+#include <BuzzKillGroup.h>
+
+// Most voices a BuzzKillPoly object can manage (4 boards in a BuzzKillGroup)
+#define BUZZKILL_POLY_VOICES 16
+
+enum buzzkill_steal_t: byte {
+    BUZZKILL_STEAL_OLDEST = 0,      // the voice whose note started longest ago
+    BUZZKILL_STEAL_QUIETEST = 1     // the voice with the lowest velocity, or the oldest of those
+};
+
+/**
+ * Plays notes on the voices of a BuzzKill board (or a BuzzKillGroup) by note number, as from a MIDI keyboard,
+ * choosing a voice for each new note. A free voice is used if there is one, preferring the one released longest ago;
+ * otherwise a sounding voice is taken over ("stolen"). Velocity sets the voice's mix volume.
+ * Only the frequency, mix volume and gate of each voice are changed, so shapes, envelopes and patches are set up
+ * beforehand as usual, and the voices must be enabled. Each note sends only the registers that change.
+ *
+ *     BuzzKillPoly poly(buzzkill);
+ *     poly.noteOn(60, 100);     // middle C
+ *     poly.noteOn(64, 100);     // E, on another voice
+ *     poly.noteOff(60);
+ */
+class BuzzKillPoly {
+public:
+    /**
+     * Constructor, for the voices of a single board.
+     * @param buzzkill       The BuzzKill object for the board
+     */
+    BuzzKillPoly(BuzzKill &buzzkill);
+
+
+    /**
+     * Constructor, for the voice pool of a group of boards.
+     * @param group          The BuzzKillGroup object for the boards
+     */
+    BuzzKillPoly(BuzzKillGroup &group);
+
+
+    /**
+     * Choose which voices are used for notes; any others are left alone (e.g. for sound effects or drums).
+     * Stops all notes.
+     * @param first          The first voice to use
+     * @param count          The number of voices to use, starting from the first
+     */
+    void useVoices(byte first,
+                   byte count);
+
+
+    /**
+     * Choose how a voice is chosen to be stolen when a note starts and all voices are sounding.
+     * @param mode           BUZZKILL_STEAL_OLDEST (the default) or BUZZKILL_STEAL_QUIETEST
+     */
+    void setStealMode(buzzkill_steal_t mode);
+
+
+    /**
+     * Start a note. If the note is already sounding, its voice is started again.
+     * A velocity of 0 stops the note instead, as in MIDI.
+     * @param note           The MIDI note number (0..107), e.g. 60 for middle C
+     * @param velocity       (optional) How hard the note is played (1..127), setting the mix volume; defaults to 127
+     * @return               The voice number used, or 255 if no note was started
+     */
+    byte noteOn(byte note,
+                byte velocity=127);
+
+
+    /**
+     * Stop a note, clearing the gate bit of its voice so that the envelope is released.
+     * @param note           The MIDI note number (0..107)
+     */
+    void noteOff(byte note);
+
+
+    /**
+     * Stop all notes.
+     */
+    void allNotesOff();
+
+
+    /**
+     * Bend the pitch of all notes, including those started later.
+     * @param cents          The pitch change in cents (e.g. 200 for a whole tone up, -100 for a semitone down)
+     */
+    void pitchBend(int cents);
+
+private:
+    BuzzKill *_buzzkill=nullptr;
+    BuzzKillGroup *_group=nullptr;
+    byte _first=0;
+    byte _count=4;
+    buzzkill_steal_t _stealMode=BUZZKILL_STEAL_OLDEST;
+    int _bend=0;
+    word _clock=0;
+    byte _notes[BUZZKILL_POLY_VOICES];
+    byte _velocities[BUZZKILL_POLY_VOICES];
+    word _times[BUZZKILL_POLY_VOICES];
+    bool _gates[BUZZKILL_POLY_VOICES];
+    BuzzKill &_board(byte voice);
+    byte _findVoice(byte note);
+    void _gate(byte voice, bool gate);
+    void _beginBatch();
+    void _commitBatch();
+};
+
+#endif // BUZZKILL_POLY_H
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillSpeech.h>
+
+// Estimated length of each phoneme at the default speech speed (162), in units of 2 ms.
+// Diphthongs are the longest sounds and stops the shortest; the pauses follow the descriptions in the board guide.
+const byte BuzzKillSpeech::_durations[55] PROGMEM = {
+  90, 90, 85, 90, 90, 90, 95, 90,              // OW AW EY AI AY EA OY UR
+  75, 75, 75, 60, 70, 75, 75, 60,              // AE AA AU EH IY AO ER AH
+  70, 50, 50, 35,                              // UW UH IH AX
+  55, 60, 50, 35, 45, 45, 50, 30,              // S* SH F* V* Z* ZH TH DH
+  40, 35, 45, 30, 40, 35, 45, 35,              // M* N* NG H* X* R* RX L*
+  45, 35, 40, 30, 25, 25, 30, 30,              // LX W* WH Y* WX YX KX GX
+  35, 30, 40, 30, 40, 35, 50, 55,              // T* D* P* B* K* G* J* CH
+  25, 60, 90                                   // _1 _2 _3
+};
+
+BuzzKillSpeech::BuzzKillSpeech(BuzzKill &buzzkill, byte buffer[], word size) : _buzzkill(buzzkill), _buffer(buffer), _size(size) {
+  _setScale();
+}
+
+bool BuzzKillSpeech::addPhonemes(const byte phonemes[], byte length) {
+  if (length == 0) for (; length<255; ++length) if (phonemes[length] == 255) break;
+  if (length == 255 || length > available()) return false;
+  for (byte count=0; count<length; ++count) _buffer[(_head+_count+count) % _size] = phonemes[count];
+  _count += length;
+  return true;
+}
+
+bool BuzzKillSpeech::addTags(const char tags[]) {
+  const char *tagptr = tags;
+  word count = 0;
+  while (count < 509 && *tagptr && *tagptr != '.') if (*tagptr++ != ' ') ++count;
+  if (count == 0 || (count%2) == 1 || (count>>1) > available()) return false;
+  for (tagptr = tags; count > 0; count -= 2) {
+    while (*tagptr == ' ') ++tagptr;
+    _buffer[(_head+_count++) % _size] = _buzzkill.getPhonemeFromTag(tagptr);
+    tagptr += 2;
+  }
+  return true;
+}
+
+bool BuzzKillSpeech::addPhrase(const byte phrase[]) {
+  byte length = 0;
+  while (length < 255 && pgm_read_byte(phrase + length) != 255) ++length;
+  if (length == 255 || length > available()) return false;
+  for (byte count=0; count<length; ++count) _buffer[(_head+_count+count) % _size] = pgm_read_byte(phrase + count);
+  _count += length;
+  return true;
+}
+
+word BuzzKillSpeech::available() {
+  return _size - _count;
+}
+
+void BuzzKillSpeech::setSpeed(byte speed) {
+  if (speed > 253) return;
+  _speed = speed;
+  _buzzkill.setSpeechSpeed(speed);
+  _setScale();
+}
+
+void BuzzKillSpeech::setTiming(byte percent) {
+  if (percent == 0) return;
+  _timing = percent;
+  _setScale();
+}
+
+void BuzzKillSpeech::onPhoneme(buzzkill_speech_callback_t callback) {
+  _callback = callback;
+}
+
+void BuzzKillSpeech::start() {
+  if (_speaking || _count == 0) return;
+  _begin();
+}
+
+void BuzzKillSpeech::stop() {
+  _buzzkill.stopSpeaking();
+  _buzzkill.clearSpeechBuffer();
+  _head = _count = _sent = 0;
+  _speaking = false;
+}
+
+void BuzzKillSpeech::poll() {
+  if (!_speaking) return;
+  unsigned long now = micros();
+  unsigned long length;
+  // Move past every phoneme that should be finished by now; each one starts exactly where the last one ended
+  while (_sent > 0 && now - _phonemeStart >= (length = _units(_at(0)) * _scale)) {
+    _phonemeStart += length;
+    _queued -= _units(_at(0));
+    if (++_head == _size) _head = 0;
+    --_count;
+    --_sent;
+    if (_sent > 0 && _callback) _callback(_at(0));
+  }
+  if (_sent == 0) {
+    // The board has reached the end of what it was sent: either the speech is finished, or more phonemes were
+    // added too late to follow on, or the board's buffer was full. In the last two cases, start again.
+    if (_count > 0) _begin();
+    else {
+      _speaking = false;
+      if (_callback) _callback(255);
+    }
+    return;
+  }
+  if (_queued * _scale - (now - _phonemeStart) < BUZZKILL_SPEECH_LEAD * 1000UL) _load();
+}
+
+bool BuzzKillSpeech::isSpeaking() {
+  return _speaking;
+}
+
+byte BuzzKillSpeech::_at(word index) {
+  index += _head;
+  return _buffer[index < _size ? index : index - _size];
+}
+
+byte BuzzKillSpeech::_units(byte phoneme) {
+  return (phoneme < sizeof(_durations)) ? pgm_read_byte(&_durations[phoneme]) : 0;
+}
+
+void BuzzKillSpeech::_setScale() {
+  // Microseconds per duration unit; phoneme lengths are taken to be inversely proportional to (speed + 94),
+  // which keeps the default speed at 2000
+  _scale = 512000UL / (_speed + 94) * _timing / 100;
+}
+
+void BuzzKillSpeech::_begin() {
+  _buzzkill.clearSpeechBuffer();
+  _loaded = 0;
+  _queued = 0;
+  do _load(); while (_sent < _count && _loaded < BUZZKILL_SPEECH_LOAD && _queued * _scale < BUZZKILL_SPEECH_LEAD * 1000UL);
+  _buzzkill.startSpeaking();
+  _phonemeStart = micros();
+  _speaking = true;
+  if (_callback) _callback(_at(0));
+}
+
+void BuzzKillSpeech::_load() {
+  byte chunk[BUZZKILL_SPEECH_CHUNK];
+  byte length = 0;
+  while (_sent < _count && length < BUZZKILL_SPEECH_CHUNK && _loaded < BUZZKILL_SPEECH_LOAD) {
+    chunk[length] = _at(_sent++);
+    _queued += _units(chunk[length]);
+    // Near the limit, stop after a pause, so that restarting the board's buffer is not heard
+    if (++_loaded >= BUZZKILL_SPEECH_LOAD - BUZZKILL_SPEECH_BREAK && chunk[length] >= 52) _loaded = BUZZKILL_SPEECH_LOAD;
+    ++length;
+  }
+  if (length > 0) _buzzkill.addSpeechPhonemes(chunk, length);
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_SPEECH_H
+#define BUZZKILL_SPEECH_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+
+// Estimated speaking time (in ms) kept loaded on the board ahead of the current phoneme
+#define BUZZKILL_SPEECH_LEAD 400
+// Most phonemes sent to the board in one command
+#define BUZZKILL_SPEECH_CHUNK 8
+// Most phonemes loaded into the board's speech buffer before it is cleared and started again
+#define BUZZKILL_SPEECH_LOAD 240
+// Within this many phonemes of BUZZKILL_SPEECH_LOAD, loading stops early at a pause
+#define BUZZKILL_SPEECH_BREAK 48
+
+typedef void (*buzzkill_speech_callback_t)(byte phoneme);
+
+/**
+ * Plays speech of any length through a BuzzKill board, sending phonemes a few at a time while the board speaks.
+ * Phonemes are held in a buffer supplied by the caller until they are needed. The board does not report its progress,
+ * so the player estimates how long each phoneme takes at the current speech speed, and keeps about BUZZKILL_SPEECH_LEAD ms
+ * of speech loaded ahead of the estimated position. poll() must be called frequently (e.g. from loop()) while speaking.
+ * The board's own speech buffer is cleared and restarted at a pause after about BUZZKILL_SPEECH_LOAD phonemes.
+ *
+ *     byte speechBuffer[64];
+ *     BuzzKillSpeech speech(buzzkill, speechBuffer, sizeof(speechBuffer));
+ *     speech.addTags("H* EH L* OW");
+ *     speech.start();
+ *     // then call speech.poll() from loop(), adding more phonemes whenever there is room
+ */
+class BuzzKillSpeech {
+public:
+    /**
+     * Constructor.
+     * @param buzzkill       The BuzzKill object to speak through
+     * @param buffer         A byte array to hold phonemes waiting to be spoken; must remain valid while the player is used
+     * @param size           The size of the buffer in bytes; at least BUZZKILL_TEXT_CHUNK when used with BuzzKillText
+     */
+    BuzzKillSpeech(BuzzKill &buzzkill,
+                   byte buffer[],
+                   word size);
+
+
+    /**
+     * Add phonemes to the end of the speech, pulling from an array of byte values.
+     * The array may be terminated by a value of 0xff, or a total length may be specified.
+     * @param phonemes       An array of phoneme byte values, possibly terminated by 0xff value
+     * @param length         (optional) Number of phonemes to add, if array is unterminated
+     * @return               True if successful, false if there is not enough room (nothing is added)
+     */
+    bool addPhonemes(const byte phonemes[],
+                     byte length=0);
+
+
+    /**
+     * Add phonemes to the end of the speech, translating text tags from a C-style string.
+     * The string may be terminated by a period('.') or a null char (0x00), as for BuzzKill::addSpeechTags().
+     * @param tags           A string containing a sequence of two-letter text tags
+     * @return               True if successful, false if there is not enough room (nothing is added)
+     */
+    bool addTags(const char tags[]);
+
+
+    /**
+     * Add phonemes to the end of the speech, from a phrase in program memory (e.g. one defined with BUZZKILL_PHRASE).
+     * @param phrase         An array of phoneme byte values in program memory, terminated by 0xff value
+     * @return               True if successful, false if there is not enough room (nothing is added)
+     */
+    bool addPhrase(const byte phrase[]);
+
+
+    /**
+     * Get the number of phonemes that can be added now.
+     */
+    word available();
+
+
+    /**
+     * Set the speech speed (0-253), on the board and in the player's timing estimates.
+     * Use this instead of BuzzKill::setSpeechSpeed() while the player is in use.
+     * @param speed          Speech speed value; higher values result in faster speech
+     */
+    void setSpeed(byte speed);
+
+
+    /**
+     * Adjust the player's timing estimates, if they run ahead of or behind the board.
+     * @param percent        Estimated phoneme lengths, as a percentage of the built-in values; defaults to 100
+     */
+    void setTiming(byte percent);
+
+
+    /**
+     * Set a function to be called by poll() as each phoneme begins, e.g. for lip-sync or captions.
+     * The function receives the phoneme value, or 255 when the speech is finished.
+     * @param callback       The function to call, or nullptr for none
+     */
+    void onPhoneme(buzzkill_speech_callback_t callback);
+
+
+    /**
+     * Start speaking the phonemes added so far. Phonemes added while speaking follow on without a break.
+     * Has no effect if already speaking, or if there are no phonemes waiting.
+     */
+    void start();
+
+
+    /**
+     * Stop speaking at once, discarding any phonemes not yet spoken. The phoneme callback is not called.
+     */
+    void stop();
+
+
+    /**
+     * Update the estimated position, calling the phoneme callback at each boundary, and send more phonemes to the board
+     * if they are needed. At most BUZZKILL_SPEECH_CHUNK phonemes are sent per call.
+     */
+    void poll();
+
+
+    /**
+     * Check whether the board is (estimated to be) speaking.
+     * @return               True from start() until the last phoneme added is finished
+     */
+    bool isSpeaking();
+
+private:
+    BuzzKill &_buzzkill;
+    byte *_buffer;
+    word _size;
+    word _head=0;
+    word _count=0;
+    word _sent=0;
+    byte _loaded=0;
+    bool _speaking=false;
+    unsigned long _phonemeStart;
+    word _queued=0;
+    unsigned long _scale;
+    byte _speed=162;
+    byte _timing=100;
+    buzzkill_speech_callback_t _callback=nullptr;
+    static const byte _durations[55] PROGMEM;
+    friend class BuzzKillText;
+    byte _at(word index);
+    byte _units(byte phoneme);
+    void _setScale();
+    void _begin();
+    void _load();
+};
+
+#endif // BUZZKILL_SPEECH_H
@@ -0,0 +1,419 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillText.h>
+
+// Letter-to-sound rules, after Elovitz et al., "Automatic Translation of English Text to Phonetics by Means of
+// Letter-to-Sound Rules" (NRL Report 7948, 1976), with the output given as phoneme tags.
+// Each rule is written left[match]right=phonemes, and rules are separated by '|'. The rules for each letter are
+// tried in order, and the first one whose match text and both contexts fit is used; the last rule always fits.
+// In the contexts, letters must match exactly, and the following symbols are used:
+//   ' '  the start or end of the word          '#'  one or more vowels
+//   ':'  zero or more consonants               '^'  one consonant
+//   '.'  one voiced consonant                  '+'  E, I or Y
+//   '&'  one of S C G Z X J CH SH              '@'  one of T S R D L Z N J TH CH SH
+//   '%'  one of the suffixes E ED ER ES ELY ING
+static const char _rulesA[] PROGMEM =
+  "[A] =AX| [ARE] =AAR*| [AR]O=AXR*|[AR]#=EHR*|^[AS]#=EYS*|[A]WA=AX|[AW]=AO| :[ANY]=EHN*IY|[A]^+#=EY|"
+  "#:[ALLY]=AXL*IY| [AL]#=AXL*|[AGAIN]=AXG*EHN*|#:[AG]E=IHJ*|[A]^+:#=AE| :[A]^+ =EY|[A]^%=EY|"
+  " [ARR]=AXR*|[ARR]=AER*| :[AR] =AAR*|[AR] =ER|[AR]=AAR*|[AIR]=EHR*|[AI]=EY|[AY]=EY|[AU]=AO|"
+  "#:[AL] =AXL*|#:[ALS] =AXL*Z*|[ALK]=AOK*|[AL]^=AOL*| :[ABLE]=EYB*AXL*|[ABLE]=AXB*AXL*|[ANG]+=EYN*J*|"
+  "[A]=AE";
+static const char _rulesB[] PROGMEM =
+  " [BE]^#=B*IH|[BEING]=B*IYIHNG| [BOTH] =B*OWTH| [BUS]#=B*IHZ*|[BUIL]=B*IHL*|[B]=B*";
+static const char _rulesC[] PROGMEM =
+  " [CH]^=K*|^E[CH]=K*|[CH]=CH| S[CI]#=S*AY|[CI]A=SH|[CI]O=SH|[CI]EN=SH|[C]+=S*|[CK]=K*|[COM]%=K*AHM*|"
+  "[C]=K*";
+static const char _rulesD[] PROGMEM =
+  "#:[DED] =D*IHD*|.E[D] =D*|#:^E[D] =T*| [DE]^#=D*IH| [DO] =D*UW| [DOES]=D*AHZ*| [DOING]=D*UWIHNG|"
+  " [DOW]=D*AW|[DU]A=J*UW|[D]=D*";
+static const char _rulesE[] PROGMEM =
+  "#:[E] =|':^[E] =| :[E] =IY|#[ED] =D*|#:[E]D =|[EV]ER=EHV*|[E]^%=IY|[ERI]#=IYR*IY|[ERI]=EHR*IH|"
+  "#:[ER]#=ER|[ER]#=EHR*|[ER]=ER| [EVEN]=IYV*EHN*|#:[E]W=|@[EW]=UW|[EW]=Y*UW|[E]O=IY|#:&[ES] =IHZ*|"
+  "#:[E]S =|#:[ELY] =L*IY|#:[EMENT]=M*EHN*T*|[EFUL]=F*UHL*|[EE]=IY|[EARN]=ERN*| [EAR]^=ER|[EAD]=EHD*|"
+  "#:[EA] =IYAX|[EA]SU=EH|[EA]=IY|[EIGH]=EY|[EI]=IY| [EYE]=AY|[EY]=IY|[EU]=Y*UW|[E]=EH";
+static const char _rulesF[] PROGMEM =
+  "[FUL]=F*UHL*|[F]=F*";
+static const char _rulesG[] PROGMEM =
+  "[GIV]=G*IHV*| [G]I^=G*|[GE]T=G*EH|SU[GGES]=G*J*EHS*|[GG]=G*| B#[G]=G*|[G]+=J*|[GREAT]=G*R*EYT*|"
+  "#[GH]=|[G]=G*";
+static const char _rulesH[] PROGMEM =
+  " [HAV]=H*AEV*| [HERE]=H*IYR*| [HOUR]=AWER|[HOW]=H*AW|[H]#=H*|[H]=";
+static const char _rulesI[] PROGMEM =
+  " [IN]=IHN*| [I] =AY|[IN]D=AYN*|[IER]=IYER|#:R[IED]=IYD*|[IED] =AYD*|[IEN]=IYEHN*|[IE]T=AYEH|"
+  " :[I]%=AY|[I]%=IY|[IE]=IY|[I]^+:#=IH|[IR]#=AYR*|[IZ]%=AYZ*|[IS]%=AYZ*|[I]D%=AY|+^[I]^+=IH|[I]T%=AY|"
+  "#:^[I]^+=IH|[I]^+=AY|[IR]=ER|[IGH]=AY|[ILD]=AYL*D*|[IGN] =AYN*|[IGN]^=AYN*|[IGN]%=AYN*|[IQUE]=IYK*|"
+  "[I]=IH";
+static const char _rulesJ[] PROGMEM =
+  "[J]=J*";
+static const char _rulesK[] PROGMEM =
+  " [K]N=|[K]=K*";
+static const char _rulesL[] PROGMEM =
+  "[LO]C#=L*OW|L[L]=|#:^[L]%=AXL*|[LEAD]=L*IYD*|[L]=L*";
+static const char _rulesM[] PROGMEM =
+  "[MOV]=M*UWV*|[M]=M*";
+static const char _rulesN[] PROGMEM =
+  "E[NG]+=N*J*|[NG]R=NGG*|[NG]#=NGG*|[NGL]%=NGG*AXL*|[NG]=NG|[NK]=NGK*| [NOW] =N*AW|[N]=N*";
+static const char _rulesO[] PROGMEM =
+  "[OF] =AXV*|[OROUGH]=EROW|#:[OR] =ER|#:[ORS] =ERZ*|[OR]=AOR*| [ONE]=W*AHN*|[OW]=OW| [OVER]=OWV*ER|"
+  "[OV]=AHV*|[O]^%=OW|[O]^EN=OW|[O]^I#=OW|[OL]D=OWL*|[OUGHT]=AOT*|[OUGH]=AHF*| [OU]=AW|H[OU]S#=AW|"
+  "[OUS]=AXS*|[OUR]=AOR*|[OULD]=UHD*|^[OU]^L=AH|[OUP]=UWP*|[OU]=AW|[OY]=OY|[OING]=OWIHNG|[OI]=OY|"
+  "[OOR]=AOR*|[OOK]=UHK*|[OOD]=UHD*|[OO]=UW|[O]E=OW|[O] =OW|[OA]=OW| [ONLY]=OWN*L*IY| [ONCE]=W*AHN*S*|"
+  "[ON'T]=OWN*T*|C[O]N=AA|[O]NG=AO| :^[O]N=AH|I[ON]=AXN*|#:[ON] =AXN*|#^[ON]=AXN*|[O]ST =OW|[OF]^=AOF*|"
+  "[OTHER]=AHDHER|[OSS] =AOS*|#:^[OM]=AHM*|[O]=AA";
+static const char _rulesP[] PROGMEM =
+  "[PH]=F*|[PEOP]=P*IYP*|[POW]=P*AW|[PUT] =P*UHT*|[P]=P*";
+static const char _rulesQ[] PROGMEM =
+  "[QUAR]=K*W*AOR*|[QU]=K*W*|[Q]=K*";
+static const char _rulesR[] PROGMEM =
+  " [RE]^#=R*IY|[R]=R*";
+static const char _rulesS[] PROGMEM =
+  "[SH]=SH|#[SION]=ZHAXN*|[SOME]=S*AHM*|#[SUR]#=ZHER|[SUR]#=SHER|#[SU]#=ZHUW|#[SSU]#=SHUW|#[SED] =Z*D*|"
+  "#[S]#=Z*|[SAID]=S*EHD*|^[SION]=SHAXN*|[S]S=|.[S] =Z*|#:.E[S] =Z*|#:^##[S] =Z*|#:^#[S] =S*|U[S] =S*|"
+  " :#[S] =Z*| [SCH]=S*K*|[S]C+=|#[SM]=Z*M*|#[SN]'=Z*AXN*|[S]=S*";
+static const char _rulesT[] PROGMEM =
+  " [THE] =DHAX|[TO] =T*UW|[THAT] =DHAET*| [THIS] =DHIHS*| [THEY]=DHEY| [THERE]=DHEHR*|[THER]=DHER|"
+  "[THEIR]=DHEHR*| [THAN] =DHAEN*| [THEM] =DHEHM*|[THESE] =DHIYZ*| [THEN]=DHEHN*|[THROUGH]=THR*UW|"
+  "[THOSE]=DHOWZ*|[THOUGH] =DHOW| [THUS]=DHAHS*|[TH]=TH|#:[TED] =T*IHD*|S[TI]#N=CH|[TI]O=SH|[TI]A=SH|"
+  "[TIEN]=SHAXN*|[TUR]#=CHER|[TU]A=CHUW| [TWO]=T*UW|[T]=T*";
+static const char _rulesU[] PROGMEM =
+  " [UN]I=Y*UWN*| [UN]=AHN*| [UPON]=AXP*AON*|@[UR]#=UHR*|[UR]#=Y*UHR*|[UR]=ER|[U]^ =AH|[U]^^=AH|"
+  "[UY]=AY| G[U]#=|G[U]%=|G[U]#=W*|#N[U]=Y*UW|@[U]=UW|[U]=Y*UW";
+static const char _rulesV[] PROGMEM =
+  "[VIEW]=V*Y*UW|[V]=V*";
+static const char _rulesW[] PROGMEM =
+  " [WERE]=W*ER|[WA]S=W*AA|[WA]T=W*AA|[WHERE]=WHEHR*|[WHAT]=WHAAT*|[WHOL]=H*OWL*|[WHO]=H*UW|[WH]=WH|"
+  "[WAR]=W*AOR*|[WOR]^=W*ER|[WR]=R*|[W]=W*";
+static const char _rulesX[] PROGMEM =
+  "[X]=K*S*";
+static const char _rulesY[] PROGMEM =
+  "[YOUNG]=Y*AHNG| [YOU]=Y*UW| [YES]=Y*EHS*| [Y]=Y*|#:^[Y] =IY|#:^[Y]I=IY| :[Y] =AY| :[Y]#=AY|"
+  " :[Y]^+:#=IH| :[Y]^#=AY|[Y]=IH";
+static const char _rulesZ[] PROGMEM =
+  "[Z]=Z*";
+static const char _rulesApostrophe[] PROGMEM =
+  "#:.E['S] =Z*|.['S] =Z*|#['S] =Z*|[']=";
+
+static const char * const _rules[] PROGMEM = {
+  _rulesA, _rulesB, _rulesC, _rulesD, _rulesE, _rulesF, _rulesG, _rulesH, _rulesI, _rulesJ, _rulesK, _rulesL, _rulesM,
+  _rulesN, _rulesO, _rulesP, _rulesQ, _rulesR, _rulesS, _rulesT, _rulesU, _rulesV, _rulesW, _rulesX, _rulesY, _rulesZ,
+  _rulesApostrophe
+};
+
+// Phonemes for the words used to read numbers and symbols, separated by '|':
+// zero to nineteen (0..19), twenty to ninety (20..27), hundred, thousand, million, point, percent, and, plus (28..34)
+static const char _words[] PROGMEM =
+  "Z*IYR*OW|W*AHN*|T*UW|THR*IY|F*AOR*|F*AYV*|S*IHK*S*|S*EHV*AXN*|EYT*|N*AYN*|T*EHN*|IHL*EHV*AXN*|"
+  "T*W*EHLXV*|THERT*IYN*|F*AOR*T*IYN*|F*IHF*T*IYN*|S*IHK*S*T*IYN*|S*EHV*AXN*T*IYN*|EYT*IYN*|"
+  "N*AYN*T*IYN*|T*W*EHN*T*IY|THERT*IY|F*AOR*T*IY|F*IHF*T*IY|S*IHK*S*T*IY|S*EHV*AXN*T*IY|EYT*IY|"
+  "N*AYN*T*IY|H*AHN*D*R*IHD*|THAWZ*AXN*D*|M*IHL*Y*AXN*|P*OYN*T*|P*ERS*EHN*T*|AEN*D*|P*L*AHS*";
+
+#define BUZZKILL_WORD_TENS 18
+#define BUZZKILL_WORD_HUNDRED 28
+#define BUZZKILL_WORD_THOUSAND 29
+#define BUZZKILL_WORD_MILLION 30
+#define BUZZKILL_WORD_POINT 31
+#define BUZZKILL_WORD_PERCENT 32
+#define BUZZKILL_WORD_AND 33
+#define BUZZKILL_WORD_PLUS 34
+
+// Phoneme values used directly; values below BUZZKILL_PHONEME_VOWELS are vowels
+#define BUZZKILL_PHONEME_VOWELS 20
+#define BUZZKILL_PHONEME_L 35
+#define BUZZKILL_PHONEME_LX 36
+#define BUZZKILL_PHONEME_PAUSE2 53
+#define BUZZKILL_PHONEME_PAUSE3 54
+
+static bool _isLetter(char c) {
+  return c >= 'A' && c <= 'Z';
+}
+
+static bool _isVowel(char c) {
+  return c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U';
+}
+
+static bool _isConsonant(char c) {
+  return _isLetter(c) && !_isVowel(c);
+}
+
+static bool _isOneOf(char c, const char list[]) {
+  return c != 0 && strchr(list, c) != nullptr;
+}
+
+BuzzKillText::BuzzKillText(BuzzKill &buzzkill) : _buzzkill(buzzkill) {
+}
+
+BuzzKillText::BuzzKillText(BuzzKillSpeech &speech) : _buzzkill(speech._buzzkill), _speech(&speech) {
+}
+
+size_t BuzzKillText::write(uint8_t c) {
+  // Words are runs of either letters or digits; an apostrophe may continue a word of letters
+  bool number = (_wordLength > 0 && _word[0] <= '9');
+  bool digit = (c >= '0' && c <= '9');
+  bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c == '\'' && _wordLength > 0 && !number);
+  if (_period) {
+    // A period after a number is a decimal point if a digit follows, otherwise it ends a sentence
+    _period = false;
+    if (digit) {
+      _sayWord(BUZZKILL_WORD_POINT);
+      _decimal = true;
+    }
+    else _emit(BUZZKILL_PHONEME_PAUSE3);
+  }
+  if (digit || letter) {
+    if (_wordLength > 0 && (digit != number || _wordLength == BUZZKILL_TEXT_WORD)) _endWord();
+    _word[_wordLength++] = (c >= 'a') ? c - 32 : c;
+    return 1;
+  }
+  _endWord();
+  switch (c) {
+    case '.':
+      if (number) _period = true;
+      else _emit(BUZZKILL_PHONEME_PAUSE3);
+      break;
+    case '!': case '?': case ';': case ':':
+      _emit(BUZZKILL_PHONEME_PAUSE3);
+      break;
+    case ',':
+      _emit(BUZZKILL_PHONEME_PAUSE2);
+      break;
+    case '%':
+      _sayWord(BUZZKILL_WORD_PERCENT);
+      break;
+    case '&':
+      _sayWord(BUZZKILL_WORD_AND);
+      break;
+    case '+':
+      _sayWord(BUZZKILL_WORD_PLUS);
+      break;
+  }
+  return 1;
+}
+
+void BuzzKillText::flush() {
+  _endWord();
+  if (_period) {
+    _period = false;
+    _emit(BUZZKILL_PHONEME_PAUSE3);
+  }
+  _emit(255);
+  _sendOut();
+}
+
+char BuzzKillText::_at(int8_t index) {
+  return (index >= 0 && index < _wordLength) ? _word[index] : ' ';
+}
+
+bool BuzzKillText::_matchLeft(const char *pattern, byte length, int8_t index) {
+  // The left context is matched backward, starting from the letter before the match text
+  for (byte pos=length; pos>0; --pos) {
+    char symbol = pgm_read_byte(pattern + pos - 1), c = _at(index);
+    switch (symbol) {
+      case ' ':
+        if (_isLetter(c)) return false;
+        --index;
+        break;
+      case '#':
+        if (!_isVowel(c)) return false;
+        while (_isVowel(_at(index))) --index;
+        break;
+      case ':':
+        while (_isConsonant(_at(index))) --index;
+        break;
+      case '^':
+        if (!_isConsonant(c)) return false;
+        --index;
+        break;
+      case '.':
+        if (!_isOneOf(c, "BDVGJLMNRWZ")) return false;
+        --index;
+        break;
+      case '+':
+        if (!_isOneOf(c, "EIY")) return false;
+        --index;
+        break;
+      case '&':
+        if (c == 'H' && _isOneOf(_at(index-1), "CS")) index -= 2;
+        else if (_isOneOf(c, "SCGZXJ")) --index;
+        else return false;
+        break;
+      case '@':
+        if (c == 'H' && _isOneOf(_at(index-1), "TCS")) index -= 2;
+        else if (_isOneOf(c, "TSRDLZNJ")) --index;
+        else return false;
+        break;
+      default:
+        if (c != symbol) return false;
+        --index;
+    }
+  }
+  return true;
+}
+
+bool BuzzKillText::_matchRight(const char *pattern, byte length, int8_t index) {
+  for (byte pos=0; pos<length; ++pos) {
+    char symbol = pgm_read_byte(pattern + pos), c = _at(index);
+    switch (symbol) {
+      case ' ':
+        if (_isLetter(c)) return false;
+        ++index;
+        break;
+      case '#':
+        if (!_isVowel(c)) return false;
+        while (_isVowel(_at(index))) ++index;
+        break;
+      case ':':
+        while (_isConsonant(_at(index))) ++index;
+        break;
+      case '^':
+        if (!_isConsonant(c)) return false;
+        ++index;
+        break;
+      case '.':
+        if (!_isOneOf(c, "BDVGJLMNRWZ")) return false;
+        ++index;
+        break;
+      case '+':
+        if (!_isOneOf(c, "EIY")) return false;
+        ++index;
+        break;
+      case '%':
+        // Suffixes: E, ED, ER, ES, ELY, ING
+        if (c == 'E') {
+          ++index;
+          if (_at(index) == 'L' && _at(index+1) == 'Y') index += 2;
+          else if (_isOneOf(_at(index), "DRS")) ++index;
+        }
+        else if (c == 'I' && _at(index+1) == 'N' && _at(index+2) == 'G') index += 3;
+        else return false;
+        break;
+      default:
+        if (c != symbol) return false;
+        ++index;
+    }
+  }
+  return true;
+}
+
+void BuzzKillText::_endWord() {
+  if (_wordLength == 0) return;
+  if (_word[0] <= '9') _convertNumber();
+  else _convertLetters();
+  _wordLength = 0;
+  _emit(255);
+}
+
+void BuzzKillText::_convertLetters() {
+  int8_t index = 0;
+  while (index < _wordLength) {
+    char c = _word[index];
+    const char *rule = (const char *)pgm_read_ptr(&_rules[c == '\'' ? 26 : c - 'A']);
+    while (true) {
+      // Locate the parts of the rule: left[match]right=phonemes
+      byte open = 0, close, equals, end;
+      while (pgm_read_byte(rule + open) != '[') ++open;
+      for (close = open + 1; pgm_read_byte(rule + close) != ']'; ++close);
+      for (equals = close + 1; pgm_read_byte(rule + equals) != '='; ++equals);
+      for (end = equals + 1; pgm_read_byte(rule + end) != '|' && pgm_read_byte(rule + end) != 0; ++end);
+      byte length = close - open - 1;
+      if (_matchRight(rule + open + 1, length, index) && _matchRight(rule + close + 1, equals - close - 1, index + length) &&
+          _matchLeft(rule, open, index - 1)) {
+        _sayTags(rule + equals + 1, end - equals - 1);
+        index += length;
+        break;
+      }
+      if (pgm_read_byte(rule + end) == 0) {
+        ++index;
+        break;
+      }
+      rule += end + 1;
+    }
+  }
+}
+
+void BuzzKillText::_convertNumber() {
+  // Digits after a decimal point, numbers with leading zeros, and very long numbers are read one digit at a time
+  if (_decimal || (_word[0] == '0' && _wordLength > 1) || _wordLength > 9) {
+    for (byte index=0; index<_wordLength; ++index) _sayWord(_word[index] - '0');
+  }
+  else {
+    unsigned long number = 0;
+    for (byte index=0; index<_wordLength; ++index) number = number * 10 + (_word[index] - '0');
+    if (number == 0) _sayWord(0);
+    else _sayNumber(number);
+  }
+  _decimal = false;
+}
+
+void BuzzKillText::_sayNumber(unsigned long number) {
+  if (number >= 1000000) {
+    _sayNumber(number / 1000000);
+    _sayWord(BUZZKILL_WORD_MILLION);
+    number %= 1000000;
+  }
+  if (number >= 1000) {
+    _sayNumber(number / 1000);
+    _sayWord(BUZZKILL_WORD_THOUSAND);
+    number %= 1000;
+  }
+  if (number >= 100) {
+    _sayWord(number / 100);
+    _sayWord(BUZZKILL_WORD_HUNDRED);
+    number %= 100;
+  }
+  if (number >= 20) {
+    _sayWord(BUZZKILL_WORD_TENS + number / 10);
+    number %= 10;
+  }
+  if (number > 0) _sayWord(number);
+}
+
+void BuzzKillText::_sayTags(const char *tags, byte length) {
+  char tag[2];
+  for (byte pos=0; pos+1<length; pos+=2) {
+    tag[0] = pgm_read_byte(tags + pos);
+    tag[1] = pgm_read_byte(tags + pos + 1);
+    _emit(_buzzkill.getPhonemeFromTag(tag));
+  }
+}
+
+void BuzzKillText::_sayWord(byte wordNum) {
+  const char *tags = _words;
+  byte length;
+  while (wordNum > 0) if (pgm_read_byte(tags++) == '|') --wordNum;
+  for (length = 0; pgm_read_byte(tags + length) != '|' && pgm_read_byte(tags + length) != 0; ++length);
+  _sayTags(tags, length);
+  _emit(255);
+}
+
+void BuzzKillText::_emit(byte phoneme) {
+  // Phonemes are held back by one, so that an L before a consonant, a pause or the end of a word
+  // can be given the darker LX sound; a value of 255 marks the end of a word.
+  // A repeated consonant or pause (from a doubled letter such as the TT in "battery") is only sent once.
+  if (phoneme == _held && phoneme >= BUZZKILL_PHONEME_VOWELS) return;
+  if (_held == BUZZKILL_PHONEME_L && phoneme >= BUZZKILL_PHONEME_VOWELS) _held = BUZZKILL_PHONEME_LX;
+  if (_held != 255) {
+    _out[_outLength++] = _held;
+    if (_outLength == BUZZKILL_TEXT_CHUNK) _sendOut();
+  }
+  _held = phoneme;
+}
+
+void BuzzKillText::_sendOut() {
+  if (_outLength == 0) return;
+  if (!_speech) _buzzkill.addSpeechPhonemes(_out, _outLength);
+  else while (!_speech->addPhonemes(_out, _outLength)) {
+    // Waiting only makes room if the player is speaking; if it cannot start, the phonemes are dropped
+    if (!_speech->isSpeaking()) _speech->start();
+    if (!_speech->isSpeaking()) break;
+    _speech->poll();
+  }
+  _outLength = 0;
+}
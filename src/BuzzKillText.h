@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_TEXT_H
+#define BUZZKILL_TEXT_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+#include <BuzzKillSpeech.h>
+
+// Longest word converted as a whole; longer words are split
+#define BUZZKILL_TEXT_WORD 24
+// Number of phonemes collected before they are sent to the speech buffer
+#define BUZZKILL_TEXT_CHUNK 16
+
+/**
+ * Converts English text to phonemes and adds them to the speech buffer of a BuzzKill board.
+ * Text is handled one character at a time using the standard print() and write() methods, so any amount of text
+ * can be converted without storing it. Pronunciation follows a set of letter-to-sound rules, which handle most
+ * common words well but cannot match a dictionary. Numbers are spoken as words (e.g. "one hundred twenty three"),
+ * and punctuation adds pauses. Call flush() at the end of the text to send the last word.
+ *
+ *     BuzzKillText text(buzzkill);
+ *     text.print("The temperature is ");
+ *     text.print(21);
+ *     text.print(" degrees.");
+ *     text.flush();
+ *     buzzkill.startSpeaking();
+ */
+class BuzzKillText : public Print {
+public:
+    /**
+     * Constructor.
+     * @param buzzkill       The BuzzKill object whose speech buffer will receive the phonemes
+     */
+    BuzzKillText(BuzzKill &buzzkill);
+
+
+    /**
+     * Constructor, for text to be spoken by a BuzzKillSpeech player.
+     * When the player's buffer is full, writing waits (calling the player's poll()) until there is room,
+     * and starts the player if it is not already speaking.
+     * @param speech         The BuzzKillSpeech player which will receive the phonemes
+     */
+    BuzzKillText(BuzzKillSpeech &speech);
+
+
+    /**
+     * Convert a single character of text. Phonemes are sent to the speech buffer in groups, as words are completed.
+     * @param c              The character to convert
+     * @return               Always 1
+     */
+    size_t write(uint8_t c);
+    using Print::write;
+
+
+    /**
+     * Finish converting the text written so far, sending all remaining phonemes to the speech buffer or player.
+     */
+    void flush();
+
+private:
+    BuzzKill &_buzzkill;
+    BuzzKillSpeech *_speech=nullptr;
+    char _word[BUZZKILL_TEXT_WORD];
+    byte _wordLength=0;
+    byte _out[BUZZKILL_TEXT_CHUNK];
+    byte _outLength=0;
+    byte _held=255;
+    bool _period=false;
+    bool _decimal=false;
+    char _at(int8_t index);
+    bool _matchLeft(const char *pattern, byte length, int8_t index);
+    bool _matchRight(const char *pattern, byte length, int8_t index);
+    void _endWord();
+    void _convertLetters();
+    void _convertNumber();
+    void _sayNumber(unsigned long number);
+    void _sayTags(const char *tags, byte length);
+    void _sayWord(byte wordNum);
+    void _emit(byte phoneme);
+    void _sendOut();
+};
+
+#endif // BUZZKILL_TEXT_H
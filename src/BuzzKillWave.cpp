@@ -0,0 +1,165 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#include <BuzzKillWave.h>
+
+const word BuzzKillWave::_sineTable[65] PROGMEM = {
+  0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512,
+  10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868,
+  19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811, 25329, 25832, 26319,
+  26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956, 30273, 30571, 30852, 31113,
+  31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757, 32767
+};
+
+void BuzzKillWave::sawtooth(byte wave[], byte harmonics, byte mix) {
+  if (harmonics == 0 || harmonics > 127) return;
+  _build(wave, _SAWTOOTH, 0, nullptr, harmonics, mix);
+}
+
+void BuzzKillWave::square(byte wave[], byte harmonics, byte mix) {
+  if (harmonics == 0 || harmonics > 127) return;
+  _build(wave, _SQUARE, 0, nullptr, harmonics, mix);
+}
+
+void BuzzKillWave::triangle(byte wave[], byte harmonics, byte mix) {
+  if (harmonics == 0 || harmonics > 127) return;
+  _build(wave, _TRIANGLE, 0, nullptr, harmonics, mix);
+}
+
+void BuzzKillWave::pulse(byte wave[], byte width, byte harmonics, byte mix) {
+  if (width == 0 || harmonics == 0 || harmonics > 127) return;
+  _build(wave, _PULSE, width, nullptr, harmonics, mix);
+}
+
+void BuzzKillWave::additive(byte wave[], const byte amplitudes[], byte count, byte mix) {
+  if (count == 0 || count > 127) return;
+  _build(wave, _ADDITIVE, 0, amplitudes, count, mix);
+}
+
+void BuzzKillWave::morph(byte wave[], const byte other[], byte amount) {
+  for (word index=0; index<256; ++index) {
+    wave[index] = ((word)(255 - amount) * wave[index] + (word)amount * other[index] + 127) / 255;
+  }
+}
+
+byte BuzzKillWave::harmonicsBelow(word freq16, word limit) {
+  if (freq16 == 0) return 127;
+  unsigned long count = limit * 16UL / freq16;
+  return (count < 1) ? 1 : (count > 127) ? 127 : count;
+}
+
+word BuzzKillWave::compress(const byte wave[], byte packed[]) {
+  // The format read by loadCustomWave(): each token covers 1..64 values, given as differences from the value before
+  // (starting from 0). 00nnnnnn is followed by 4-bit differences packed two to a byte, 01nnnnnn by whole-byte
+  // differences, and 10nnnnnn repeats the last difference. A token is only ended early where that cannot cost bytes.
+  word pos = 0, end, out = 0;
+  byte delta = 0, count, index;
+  bool small;
+  while (pos < 256) {
+    count = _repeats(wave, pos, delta, 64);
+    if (count >= 2) {
+      packed[out++] = 0x80 | (count - 1);
+      pos += count;
+      continue;
+    }
+    // A single small difference is cheaper as part of a run of whole bytes
+    small = (_smalls(wave, pos, 2) == 2);
+    for (end=pos+1; end<256 && end-pos<64; ++end) {
+      if (_repeats(wave, end, _delta(wave, end-1), 4) == 4) break;
+      if (small ? !_small(_delta(wave, end)) : _smalls(wave, end, 4) == 4) break;
+    }
+    count = end - pos;
+    packed[out++] = (small ? 0x00 : 0x40) | (count - 1);
+    for (index=0; index<count; ++index) {
+      delta = _delta(wave, pos + index);
+      if (!small) packed[out++] = delta;
+      else if (index & 1) packed[out-1] |= delta & 15;
+      else packed[out++] = delta << 4;
+    }
+    pos = end;
+  }
+  return out;
+}
+
+int BuzzKillWave::_sine(byte phase) {
+  // A cycle has 256 points, so every harmonic lands exactly on a table entry
+  byte index = phase & 63;
+  int value = pgm_read_word(&_sineTable[(phase & 64) ? 64 - index : index]);
+  return (phase & 128) ? -value : value;
+}
+
+byte BuzzKillWave::_delta(const byte wave[], word pos) {
+  return wave[pos] - (pos ? wave[pos-1] : 0);
+}
+
+bool BuzzKillWave::_small(byte delta) {
+  return delta < 8 || delta >= 248;
+}
+
+byte BuzzKillWave::_repeats(const byte wave[], word pos, byte delta, byte most) {
+  // Number of values from pos (up to most) with the given difference
+  byte count = 0;
+  while (pos + count < 256 && count < most && _delta(wave, pos + count) == delta) ++count;
+  return count;
+}
+
+byte BuzzKillWave::_smalls(const byte wave[], word pos, byte most) {
+  // Number of values from pos (up to most) with a difference that fits in 4 bits
+  byte count = 0;
+  while (pos + count < 256 && count < most && _small(_delta(wave, pos + count))) ++count;
+  return count;
+}
+
+long BuzzKillWave::_sample(_Kind kind, byte index, byte param, const byte amplitudes[], byte count) {
+  // Sum of the harmonics at one point of the cycle, each scaled to at most 32767
+  long sum = 0;
+  for (byte harmonic=1; harmonic<=count; ++harmonic) {
+    byte phase = harmonic * index;
+    switch (kind) {
+      case _SAWTOOTH:
+        sum -= (long)(32767 / harmonic) * _sine(phase) / 32768;
+        break;
+      case _SQUARE:
+        if (harmonic & 1) sum += (long)(32767 / harmonic) * _sine(phase) / 32768;
+        break;
+      case _TRIANGLE:
+        if (!(harmonic & 1)) break;
+        if (harmonic & 2) sum -= (long)(32767 / (harmonic * harmonic)) * _sine(phase) / 32768;
+        else sum += (long)(32767 / (harmonic * harmonic)) * _sine(phase) / 32768;
+        break;
+      case _PULSE:
+        // The difference of two sawtooth waves, the second delayed by the pulse width
+        sum += (long)(32767 / harmonic) * ((long)_sine(phase) - _sine(harmonic * (byte)(index - param))) / 32768;
+        break;
+      case _ADDITIVE:
+        sum += (long)amplitudes[harmonic-1] * _sine(phase) / 256;
+        break;
+    }
+  }
+  return sum;
+}
+
+void BuzzKillWave::_build(byte wave[], _Kind kind, byte param, const byte amplitudes[], byte count, byte mix) {
+  long sample, low = 0, high = 0;
+  unsigned long range;
+  word index;
+  byte value;
+  // The first pass finds the range of the wave, so that the second can scale it to fill 0..255 as it writes
+  for (index=0; index<256; ++index) {
+    sample = _sample(kind, index, param, amplitudes, count);
+    if (index == 0 || sample < low) low = sample;
+    if (index == 0 || sample > high) high = sample;
+  }
+  range = high - low;
+  for (index=0; index<256; ++index) {
+    value = range ? ((unsigned long)(_sample(kind, index, param, amplitudes, count) - low) * 255 + range / 2) / range : 128;
+    wave[index] = ((word)(255 - mix) * wave[index] + (word)mix * value + 127) / 255;
+  }
+}
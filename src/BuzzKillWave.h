@@ -0,0 +1,143 @@
+/*
+ * This file is part of the Arduino library for the BuzzKill Sound Effects Board
+ *
+ * Version 1.0.0, last updated May 10, 2025
+ *
+ * Copyright (c) 2025 Todd E. Stidham
+ *
+ * MIT license, all text here must be included in any redistribution
+ */
+
+#ifndef BUZZKILL_WAVE_H
+#define BUZZKILL_WAVE_H
+
+#include <Arduino.h>
+#include <BuzzKill.h>
+
+// Most bytes a wave can take in compressed form
+#define BUZZKILL_WAVE_PACKED_MAX 260
+
+/**
+ * Builds custom waveforms for storeCustomWave() in a 256-byte array, using integer arithmetic only.
+ * Waves are built from a limited number of harmonics (band-limited), so that high notes played with them
+ * do not alias into unwanted tones. Each wave is scaled to fill the range 0..255.
+ *
+ * Every function can blend the new wave into what the array already holds, instead of replacing it; this gives
+ * morphs between any of the shapes without needing a second array. All functions are static, and each takes
+ * some time to run (up to about 100 ms for many harmonics on an 8-bit board), so waves are best built ahead of use.
+ *
+ *     byte wave[256];
+ *     BuzzKillWave::sawtooth(wave, 16);           // a sawtooth with 16 harmonics
+ *     BuzzKillWave::square(wave, 16, 128);        // then halfway towards a square wave
+ *     buzzkill.storeCustomWave(wave);
+ */
+class BuzzKillWave {
+public:
+    /**
+     * Build a band-limited sawtooth wave, rising through the cycle.
+     * @param wave           The array for the wave; must contain at least 256 values
+     * @param harmonics      The number of harmonics (1..127)
+     * @param mix            (optional) How much of the new wave replaces the array's contents (0..255); defaults to 255 (all)
+     */
+    static void sawtooth(byte wave[],
+                         byte harmonics,
+                         byte mix=255);
+
+
+    /**
+     * Build a band-limited square wave, high for the first half of the cycle. Only odd harmonics are present.
+     * @param wave           The array for the wave; must contain at least 256 values
+     * @param harmonics      The highest harmonic (1..127)
+     * @param mix            (optional) How much of the new wave replaces the array's contents (0..255); defaults to 255 (all)
+     */
+    static void square(byte wave[],
+                       byte harmonics,
+                       byte mix=255);
+
+
+    /**
+     * Build a band-limited triangle wave. Only odd harmonics are present.
+     * @param wave           The array for the wave; must contain at least 256 values
+     * @param harmonics      The highest harmonic (1..127)
+     * @param mix            (optional) How much of the new wave replaces the array's contents (0..255); defaults to 255 (all)
+     */
+    static void triangle(byte wave[],
+                         byte harmonics,
+                         byte mix=255);
+
+
+    /**
+     * Build a band-limited pulse wave of a given width, high at the start of the cycle.
+     * A width of 128 gives a square wave; narrower pulses sound thinner.
+     * @param wave           The array for the wave; must contain at least 256 values
+     * @param width          The part of the cycle spent high, in 256ths (1..255)
+     * @param harmonics      The number of harmonics (1..127)
+     * @param mix            (optional) How much of the new wave replaces the array's contents (0..255); defaults to 255 (all)
+     */
+    static void pulse(byte wave[],
+                      byte width,
+                      byte harmonics,
+                      byte mix=255);
+
+
+    /**
+     * Build a wave by adding sine waves at each harmonic, with the given amplitudes.
+     * @param wave           The array for the wave; must contain at least 256 values
+     * @param amplitudes     The amplitude of each harmonic from the first (the fundamental) upwards (0..255)
+     * @param count          The number of amplitudes (1..127)
+     * @param mix            (optional) How much of the new wave replaces the array's contents (0..255); defaults to 255 (all)
+     */
+    static void additive(byte wave[],
+                         const byte amplitudes[],
+                         byte count,
+                         byte mix=255);
+
+
+    /**
+     * Blend another wave into the array.
+     * @param wave           The array for the wave; must contain at least 256 values
+     * @param other          The wave to blend in; must contain at least 256 values
+     * @param amount         How much of the other wave replaces the array's contents (0..255)
+     */
+    static void morph(byte wave[],
+                      const byte other[],
+                      byte amount);
+
+
+    /**
+     * Find how many harmonics of a note stay below a frequency limit, for building a wave with no harmonics above it.
+     * @param freq16         The highest frequency the wave will be played at, in 1/16ths of a hertz, e.g. 7040 for 440 Hz
+     * @param limit          The frequency limit in hertz, e.g. a little under half the board's output sample rate
+     * @return               The number of harmonics (1..127)
+     */
+    static byte harmonicsBelow(word freq16,
+                               word limit);
+
+
+    /**
+     * Compress a wave, for storing in program memory and sending with loadCustomWave(). Smooth waves and waves with
+     * straight or level stretches compress best; a wave never takes more than BUZZKILL_WAVE_PACKED_MAX bytes.
+     * Waves are usually compressed ahead of time, e.g. by a sketch which prints them out to be pasted into another.
+     * @param wave           The wave to compress; must contain at least 256 values
+     * @param packed         The array for the compressed wave; must have space for BUZZKILL_WAVE_PACKED_MAX values
+     * @return               The length of the compressed wave in bytes
+     */
+    static word compress(const byte wave[],
+                         byte packed[]);
+
+private:
+    enum _Kind: byte { _SAWTOOTH, _SQUARE, _TRIANGLE, _PULSE, _ADDITIVE };
+
+    // Quarter of a sine wave, scaled to 0..32767, at each of the 256 points of a cycle
+    static const word _sineTable[65] PROGMEM;
+
+    static int _sine(byte phase);
+    static byte _delta(const byte wave[], word pos);
+    static bool _small(byte delta);
+    static byte _repeats(const byte wave[], word pos, byte delta, byte most);
+    static byte _smalls(const byte wave[], word pos, byte most);
+    static long _sample(_Kind kind, byte index, byte param, const byte amplitudes[], byte count);
+    static void _build(byte wave[], _Kind kind, byte param, const byte amplitudes[], byte count, byte mix);
+};
+
+#endif // BUZZKILL_WAVE_H